@@ -0,0 +1,439 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "batch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <memory>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "error.hpp"
+#include "thread_pool.hpp"
+#include "trezor/software.hpp"
+
+namespace batch
+{
+  namespace
+  {
+    //! Identities per `thread_pool` chunk; four groups of x25519 lanes.
+    constexpr const std::size_t chunk_size = 16;
+
+    //! Manifest lines parsed and derived together by `stream`.
+    constexpr const std::size_t window_lines = 4096;
+
+    std::error_code last_error() noexcept
+    {
+      return std::error_code{errno, std::system_category()};
+    }
+
+    //! Read the remainder of `fd` when it cannot be mapped.
+    expect<byte_stream> read_all(const int fd)
+    {
+      byte_stream out{};
+      std::uint8_t buffer[4096];
+      while (true)
+      {
+        const ssize_t rc = ::read(fd, buffer, sizeof(buffer));
+        if (rc < 0)
+        {
+          if (errno == EINTR)
+            continue;
+          return last_error();
+        }
+        if (rc == 0)
+          break;
+        out.write(buffer, std::size_t(rc));
+      }
+      return {std::move(out)};
+    }
+
+    bool is_space(const char c) noexcept
+    {
+      return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    span<const char> trim(span<const char> text) noexcept
+    {
+      const char* begin = text.begin();
+      const char* end = text.end();
+      while (begin != end && is_space(*begin))
+        ++begin;
+      while (begin != end && is_space(end[-1]))
+        --end;
+      return {begin, std::size_t(end - begin)};
+    }
+  } // anonymous
+
+  mapped_file::mapped_file(const char* data, const std::size_t size, byte_buffer copy) noexcept
+    : data_(data), size_(size), released_(0), copy_(std::move(copy))
+  {}
+
+  expect<mapped_file> mapped_file::open(const char* path)
+  {
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      return last_error();
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0)
+    {
+      const std::error_code error = last_error();
+      close(fd);
+      return error;
+    }
+
+    if (!S_ISREG(info.st_mode))
+    {
+      expect<byte_stream> contents = read_all(fd);
+      close(fd);
+      if (!contents)
+        return contents.error();
+
+      const std::size_t size = contents->size();
+      byte_buffer copy = contents->take_buffer();
+      const char* data = reinterpret_cast<const char*>(copy.get());
+      return mapped_file{data, size, std::move(copy)};
+    }
+
+    const std::size_t size = std::size_t(info.st_size);
+    if (size == 0)
+    {
+      close(fd);
+      return mapped_file{nullptr, 0, nullptr};
+    }
+
+    void* const memory = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    const std::error_code error = last_error();
+    close(fd);
+    if (memory == MAP_FAILED)
+      return error;
+
+    madvise(memory, size, MADV_SEQUENTIAL);
+    return mapped_file{static_cast<const char*>(memory), size, nullptr};
+  }
+
+  mapped_file::mapped_file(mapped_file&& rhs) noexcept
+    : data_(rhs.data_), size_(rhs.size_), released_(rhs.released_), copy_(std::move(rhs.copy_))
+  {
+    rhs.data_ = nullptr;
+    rhs.size_ = 0;
+    rhs.released_ = 0;
+  }
+
+  mapped_file::~mapped_file() noexcept
+  {
+    if (data_ && !copy_)
+      munmap(const_cast<char*>(data_), size_);
+  }
+
+  void mapped_file::release(const char* end) noexcept
+  {
+    if (!data_ || copy_)
+      return;
+
+    const std::size_t page = std::size_t(sysconf(_SC_PAGESIZE));
+    const std::size_t offset = (std::size_t(end - data_) / page) * page;
+    if (released_ < offset)
+    {
+      madvise(const_cast<char*>(data_) + released_, offset - released_, MADV_DONTNEED);
+      released_ = offset;
+    }
+  }
+
+  output_writer::output_writer(const int fd, const std::size_t limit)
+    : lock_(),
+      ready_(),
+      front_(),
+      back_(),
+      limit_(limit),
+      fd_(fd),
+      pending_(false),
+      done_(false),
+      error_(),
+      thread_()
+  {
+    front_.reserve(limit);
+    back_.reserve(limit);
+    thread_ = std::thread{&output_writer::run, this};
+  }
+
+  output_writer::~output_writer() noexcept
+  {
+    if (thread_.joinable())
+      finish();
+  }
+
+  void output_writer::run()
+  {
+    std::unique_lock<std::mutex> guard{lock_};
+    for (;;)
+    {
+      ready_.wait(guard, [this] { return pending_ || done_; });
+      if (!pending_)
+        return;
+
+      // `back_` is owned by this thread until `pending_` is cleared
+      guard.unlock();
+      std::error_code error{};
+      const std::uint8_t* current = back_.data();
+      const std::uint8_t* const end = current + back_.size();
+      while (current != end)
+      {
+        const ssize_t written = ::write(fd_, current, end - current);
+        if (written < 0)
+        {
+          if (errno == EINTR)
+            continue;
+          error = last_error();
+          break;
+        }
+        current += written;
+      }
+      back_.clear();
+      guard.lock();
+
+      if (error && !error_)
+        error_ = error;
+      pending_ = false;
+      ready_.notify_all();
+    }
+  }
+
+  expect<void> output_writer::swap()
+  {
+    std::unique_lock<std::mutex> guard{lock_};
+    ready_.wait(guard, [this] { return !pending_; });
+    if (error_)
+      return error_;
+
+    std::swap(front_, back_);
+    pending_ = true;
+    ready_.notify_all();
+    return success();
+  }
+
+  expect<void> output_writer::write(const span<const std::uint8_t> source)
+  {
+    if (!thread_.joinable())
+      return {common_error::invalid_argument};
+
+    front_.write(source);
+    if (front_.size() < limit_)
+      return success();
+    return swap();
+  }
+
+  expect<void> output_writer::finish()
+  {
+    if (!thread_.joinable())
+      return {common_error::invalid_argument};
+
+    expect<void> flushed = success();
+    if (front_.size())
+      flushed = swap();
+    {
+      const std::lock_guard<std::mutex> guard{lock_};
+      done_ = true;
+      ready_.notify_all();
+    }
+    thread_.join();
+
+    if (error_)
+      return error_;
+    return flushed;
+  }
+
+  reorder_buffer::reorder_buffer(sink out)
+    : lock_(), waiting_(), sink_(std::move(out)), next_(0), error_()
+  {}
+
+  expect<void> reorder_buffer::put(const std::size_t index, byte_slice value)
+  {
+    const std::lock_guard<std::mutex> guard{lock_};
+    if (error_)
+      return error_;
+
+    if (index != next_)
+    {
+      waiting_.emplace(index, std::move(value));
+      return success();
+    }
+
+    for (;;)
+    {
+      const expect<void> written = sink_(std::move(value));
+      ++next_;
+      if (!written)
+      {
+        error_ = written.error();
+        waiting_.clear();
+        return error_;
+      }
+
+      const auto ready = waiting_.find(next_);
+      if (ready == waiting_.end())
+        break;
+      value = std::move(ready->second);
+      waiting_.erase(ready);
+    }
+    return success();
+  }
+
+  std::size_t reorder_buffer::next() const
+  {
+    const std::lock_guard<std::mutex> guard{lock_};
+    return next_;
+  }
+
+  std::size_t reorder_buffer::waiting() const
+  {
+    const std::lock_guard<std::mutex> guard{lock_};
+    return waiting_.size();
+  }
+
+  span<const char> take_lines(span<const char>& text, std::size_t max_lines) noexcept
+  {
+    const char* end = text.begin();
+    while (max_lines && end != text.end())
+    {
+      end = std::find(end, text.end(), '\n');
+      if (end != text.end())
+        ++end;
+      --max_lines;
+    }
+
+    const span<const char> out{text.begin(), std::size_t(end - text.begin())};
+    text = {end, std::size_t(text.end() - end)};
+    return out;
+  }
+
+  expect<std::vector<host_info>> parse_manifest(const span<const char> text)
+  {
+    std::vector<host_info> out;
+    const char* current = text.begin();
+    while (current != text.end())
+    {
+      const char* end = std::find(current, text.end(), '\n');
+      const span<const char> line = trim({current, std::size_t(end - current)});
+      current = (end == text.end()) ? end : end + 1;
+
+      if (line.empty() || line[0] == '#')
+        continue;
+
+      const char* at = line.end();
+      for (const char* i = line.begin(); i != line.end(); ++i)
+      {
+        if (*i == '@')
+          at = i;
+      }
+
+      host_info info{};
+      if (at == line.end())
+        info.host.assign(line.begin(), line.end());
+      else
+      {
+        info.user.assign(line.begin(), at);
+        info.host.assign(at + 1, line.end());
+      }
+      if (info.host.empty())
+        return {common_error::invalid_argument};
+      out.push_back(std::move(info));
+    }
+    return out;
+  }
+
+  expect<void> derive(thread_pool& pool, const slip10::seed& seed, const span<const host_info> hosts, const encoder& encode, reorder_buffer& out)
+  {
+    std::mutex lock;
+    std::error_code error{};
+    std::atomic<bool> failed{false};
+    const auto fail = [&] (const std::error_code code)
+    {
+      const std::lock_guard<std::mutex> guard{lock};
+      if (!error)
+        error = code;
+      failed = true;
+    };
+
+    // caches are not thread-safe; each worker keeps its own across chunks
+    std::vector<std::unique_ptr<slip10::cache>> caches;
+    caches.reserve(pool.size());
+    for (std::size_t i = 0; i < pool.size(); ++i)
+      caches.push_back(trezor::software::make_cache(seed));
+
+    pool.for_each(hosts.size(), chunk_size, [&] (const std::size_t worker, const std::size_t begin, const std::size_t end)
+    {
+      if (failed)
+        return;
+
+      const span<const host_info> chunk{hosts.data() + begin, end - begin};
+      expect<std::vector<byte_slice>> secrets = trezor::software::run(seed, chunk, caches[worker].get());
+      if (!secrets)
+        return fail(secrets.error());
+
+      const expect<void> encoded = encode(chunk, to_mut_span(*secrets));
+      if (!encoded)
+        return fail(encoded.error());
+
+      for (std::size_t i = 0; i < secrets->size(); ++i)
+      {
+        const expect<void> stored = out.put(begin + i, std::move((*secrets)[i]));
+        if (!stored)
+          return fail(stored.error());
+      }
+    });
+
+    if (error)
+      return error;
+    return success();
+  }
+
+  expect<void> stream(thread_pool& pool, const slip10::seed& seed, mapped_file& manifest, const encoder& encode, output_writer& out)
+  {
+    span<const char> remaining = manifest.text();
+    while (!remaining.empty())
+    {
+      const span<const char> window = take_lines(remaining, window_lines);
+      const expect<std::vector<host_info>> hosts = parse_manifest(window);
+      if (!hosts)
+        return hosts.error();
+      manifest.release(window.end());
+
+      reorder_buffer ordered{[&out] (byte_slice line)
+      {
+        return out.write(to_span(line));
+      }};
+      MACER_CHECK(derive(pool, seed, to_span(*hosts), encode, ordered));
+    }
+    return success();
+  }
+}
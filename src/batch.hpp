@@ -0,0 +1,197 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "byte_slice.hpp"
+#include "byte_stream.hpp"
+#include "expect.hpp"
+#include "host_info.hpp"
+#include "span.hpp"
+
+class thread_pool;
+namespace slip10 { struct seed; }
+
+//! Software derivation of many identities (`--batch`) across a `thread_pool`.
+namespace batch
+{
+  /*! \brief Passes values to a sink in index order, as they complete in any
+      order. Only values waiting on an earlier index are held, so memory is
+      bounded by how far ahead the workers run, not the batch size. */
+  class reorder_buffer
+  {
+  public:
+    using sink = std::function<expect<void>(byte_slice)>;
+
+  private:
+    mutable std::mutex lock_;
+    std::map<std::size_t, byte_slice> waiting_;
+    sink sink_;
+    std::size_t next_;
+    std::error_code error_; //!< First sink error; later values are dropped
+
+  public:
+    explicit reorder_buffer(sink out);
+
+    reorder_buffer(const reorder_buffer&) = delete;
+    reorder_buffer& operator=(const reorder_buffer&) = delete;
+
+    /*! Store `value` for `index`, then pass every value that is now in
+        order to the sink. Each index must be stored exactly once.
+        \return First error from the sink, if any. */
+    expect<void> put(std::size_t index, byte_slice value);
+
+    //! \return Index of the next value the sink expects.
+    std::size_t next() const;
+
+    //! \return Values held until an earlier index completes.
+    std::size_t waiting() const;
+  };
+
+  /*! \brief Read-only view of a `--batch` manifest.
+
+      Regular files are `mmap`ed, so the manifest is never copied and pages
+      already parsed can be dropped with `release`. Pipes and other files
+      that cannot be mapped are read into memory instead. */
+  class mapped_file
+  {
+    const char* data_;
+    std::size_t size_;
+    std::size_t released_; //!< Bytes at the front returned to the kernel
+    byte_buffer copy_;     //!< Owns `data_` when the file was not mapped
+
+    mapped_file(const char* data, std::size_t size, byte_buffer copy) noexcept;
+
+  public:
+    //! \return Mapping (or copy) of the entire contents of `path`.
+    static expect<mapped_file> open(const char* path);
+
+    mapped_file(mapped_file&& rhs) noexcept;
+    ~mapped_file() noexcept;
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+    mapped_file& operator=(mapped_file&&) = delete;
+
+    span<const char> text() const noexcept { return {data_, size_}; }
+
+    /*! Drop resident pages that lie entirely before `end`, which must be
+        within `text()`. Has no effect on a copied file. Pages are read
+        again if touched later. */
+    void release(const char* end) noexcept;
+  };
+
+  /*! \brief Bounded, double-buffered writer to a file descriptor.
+
+      Callers append to one `byte_stream` while a dedicated thread writes the
+      other. Once the filling buffer reaches `limit` bytes the two are swapped;
+      if the writer thread is still busy the caller blocks. Memory is therefore
+      bounded by two buffers of about `limit` bytes, regardless of how much
+      output passes through. Only one thread may call `write` at a time. */
+  class output_writer
+  {
+    std::mutex lock_;
+    std::condition_variable ready_;
+    byte_stream front_;    //!< Filled by `write`
+    byte_stream back_;     //!< Drained by `thread_`
+    const std::size_t limit_;
+    const int fd_;
+    bool pending_;         //!< `back_` holds bytes not yet written
+    bool done_;
+    std::error_code error_; //!< First write error; later output is dropped
+    std::thread thread_;
+
+    void run();
+    expect<void> swap();
+
+  public:
+    output_writer(int fd, std::size_t limit);
+    ~output_writer() noexcept;
+
+    output_writer(const output_writer&) = delete;
+    output_writer& operator=(const output_writer&) = delete;
+
+    /*! Copy `source` into the filling buffer.
+        \return First error from writing to `fd`, if any. */
+    expect<void> write(span<const std::uint8_t> source);
+
+    /*! Write all buffered bytes and stop the writer thread. Must be called
+        before destruction to see write errors; `write` fails afterwards.
+        \return First error from writing to `fd`, if any. */
+    expect<void> finish();
+  };
+
+  /*! \return Prefix of `text` with at most `max_lines` complete lines (or the
+        unterminated remainder), and advance `text` past it. */
+  span<const char> take_lines(span<const char>& text, std::size_t max_lines) noexcept;
+
+  /*! \return Identities in `text`, one `[user@]host` per line. Surrounding
+        whitespace, blank lines and lines starting with `#` are ignored.
+        The user is everything before the last `@`. */
+  expect<std::vector<host_info>> parse_manifest(span<const char> text);
+
+  /*! Replace each of `secrets` (full 32-byte session secrets) with the
+      output bytes for the matching entry of `hosts`. Called once per chunk
+      so encodings can be batched. */
+  using encoder = std::function<expect<void>(span<const host_info> hosts, span<byte_slice> secrets)>;
+
+  /*! Run the software pipeline (path hash, SLIP-10 derive, x25519, SHA-256,
+      `encode`) for every entry of `hosts` on `pool`, and `put` each result
+      into `out` under its index. Identities are processed in chunks so each
+      worker uses the batched x25519 kernels.
+      \return First error from derivation, `encode` or `out`. */
+  expect<void> derive(
+    thread_pool& pool,
+    const slip10::seed& seed,
+    span<const host_info> hosts,
+    const encoder& encode,
+    reorder_buffer& out
+  );
+
+  /*! Parse and `derive` `manifest` a window of lines at a time, writing each
+      result to `out` in manifest order. Parsed pages of the manifest are
+      released as each window starts, so memory use does not depend on the
+      size of the manifest.
+      \return First error from parsing, derivation, `encode` or `out`. */
+  expect<void> stream(
+    thread_pool& pool,
+    const slip10::seed& seed,
+    mapped_file& manifest,
+    const encoder& encode,
+    output_writer& out
+  );
+}
@@ -0,0 +1,134 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/* Throughput of `--batch` software derivation as the worker count grows.
+   Every run is checked against the single-worker output, which must come
+   out in manifest order. Usage: `bench_batch [max_workers [identities]]`. */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "batch.hpp"
+#include "bench/bench.hpp"
+#include "byte_stream.hpp"
+#include "crypto/bip39/encoder.hpp"
+#include "thread_pool.hpp"
+#include "trezor/software.hpp"
+
+namespace
+{
+  constexpr const char mnemonic[] =
+    "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about";
+
+  expect<void> encode(const span<const host_info> hosts, span<byte_slice> secrets)
+  {
+    std::vector<byte_slice> entropy;
+    entropy.reserve(secrets.size());
+    for (const byte_slice& secret : secrets)
+      entropy.push_back(secret.get_slice(0, 32));
+    MACER_CHECK(bip39::encode(to_span(entropy), secrets));
+
+    for (std::size_t i = 0; i < hosts.size(); ++i)
+    {
+      byte_stream line{};
+      line.write(to_span(hosts[i].host));
+      line.put('\t');
+      line.write(to_span(secrets[i]));
+      line.put('\n');
+      secrets[i] = byte_slice{std::move(line)};
+    }
+    return success();
+  }
+
+  //! \return Concatenated output of one batch run, or empty on error.
+  std::string run(thread_pool& pool, const slip10::seed& seed, const std::vector<host_info>& hosts)
+  {
+    std::string out;
+    batch::reorder_buffer ordered{[&out] (byte_slice line) -> expect<void>
+    {
+      out.append(reinterpret_cast<const char*>(line.data()), line.size());
+      return success();
+    }};
+    if (!batch::derive(pool, seed, to_span(hosts), encode, ordered))
+      return {};
+    return out;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const std::size_t max_workers = 1 < argc ?
+    std::strtoul(argv[1], nullptr, 10) : std::max(1u, std::thread::hardware_concurrency());
+  const std::size_t count = 2 < argc ? std::strtoul(argv[2], nullptr, 10) : 256;
+
+  const expect<slip10::seed> seed = trezor::software::make_seed({mnemonic, sizeof(mnemonic) - 1}, nullptr);
+  if (!seed)
+  {
+    std::fprintf(stderr, "make_seed: %s\n", seed.error().message().c_str());
+    return 1;
+  }
+
+  std::vector<host_info> hosts(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    hosts[i].host = "host" + std::to_string(i) + ".example.com";
+    hosts[i].user = (i % 3) ? "user" : "";
+  }
+
+  std::string expected;
+  {
+    thread_pool single{1};
+    expected = run(single, *seed, hosts);
+    if (expected.empty())
+    {
+      std::fprintf(stderr, "batch derivation failed\n");
+      return 1;
+    }
+  }
+
+  double base = 0;
+  for (std::size_t workers = 1; workers <= max_workers; ++workers)
+  {
+    thread_pool pool{workers};
+    if (run(pool, *seed, hosts) != expected)
+    {
+      std::fprintf(stderr, "%zu workers: output differs from one worker\n", workers);
+      return 1;
+    }
+
+    const std::string name = "batch/" + std::to_string(count) + "/workers=" + std::to_string(workers);
+    const double ns = bench::run(name.c_str(), [&] () { bench::do_not_optimize(run(pool, *seed, hosts)); });
+    if (workers == 1)
+      base = ns;
+    std::printf("%-44s %12.0f identities/s %8.2fx\n", "", count * 1e9 / ns, base / ns);
+  }
+  return 0;
+}
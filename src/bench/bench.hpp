@@ -0,0 +1,97 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+/* Minimal timing harness shared by the `bench_*` programs. The programs are
+   not built by default; run `make bench_<name>` then execute the binary. */
+
+namespace bench
+{
+  //! Prevents the compiler from discarding computations of `value`.
+  template<typename T>
+  inline void do_not_optimize(const T& value) noexcept
+  {
+    asm volatile("" : : "r,m"(value) : "memory");
+  }
+
+  //! Prevents the compiler from assuming memory is unchanged.
+  inline void clobber() noexcept
+  {
+    asm volatile("" : : : "memory");
+  }
+
+  struct timed
+  {
+    std::uint64_t calls;   //!< Excluding the warm-up call
+    double ns_per_call;
+  };
+
+  /*! Call `f` once to warm caches and lazy initialization, then `after_warm`
+      (a snapshot point for other counters), then `f` in doubling batches
+      until at least `min_time` elapses. */
+  template<typename F, typename G>
+  timed measure(F f, G after_warm, const std::chrono::milliseconds min_time = std::chrono::milliseconds{200})
+  {
+    using clock = std::chrono::steady_clock;
+
+    f();
+    after_warm();
+    std::uint64_t iterations = 1;
+    std::uint64_t total = 0;
+    const clock::time_point start = clock::now();
+    clock::duration elapsed{};
+    while (elapsed < min_time)
+    {
+      for (std::uint64_t i = 0; i < iterations; ++i)
+        f();
+      total += iterations;
+      iterations *= 2;
+      elapsed = clock::now() - start;
+    }
+    return {total, std::chrono::duration<double, std::nano>(elapsed).count() / total};
+  }
+
+  /*! Run `f` in batches until at least `min_time` elapses, then print the
+      mean time per call. If `bytes` is non-zero, throughput is printed too.
+      \return Nanoseconds per call of `f`. */
+  template<typename F>
+  double run(const char* name, F f, const std::size_t bytes = 0, const std::chrono::milliseconds min_time = std::chrono::milliseconds{200})
+  {
+    const double ns = measure(f, [] {}, min_time).ns_per_call;
+    if (bytes)
+      std::printf("%-44s %12.1f ns/op %10.1f MB/s\n", name, ns, (bytes * 1000.0) / ns);
+    else
+      std::printf("%-44s %12.1f ns/op\n", name, ns);
+    return ns;
+  }
+}
@@ -0,0 +1,313 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/* Microbenchmarks of the device data path: protobuf encode and decode of the
+   messages exchanged for a password, report packing, `byte_stream` and
+   `byte_slice` primitives, SHA-256 and BIP-39 encoding. Prints one JSON
+   object per line with `ns_per_op`, `allocs_per_op` and `bytes_per_op`, so
+   runs can be diffed against a saved baseline. Run with `make bench`, or
+   `bench_core [filter]` to run benchmarks whose name contains `filter`. */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "byte_chain.hpp"
+#include "byte_slice.hpp"
+#include "byte_stream.hpp"
+#include "crypto/bip39/encoder.hpp"
+#include "crypto/sha256.h"
+#include "heap.hpp"
+#include "host_info.hpp"
+#include "trezor/crypto.hpp"
+#include "trezor/framing.hpp"
+#include "trezor/identity.hpp"
+#include "wire/protobuf.hpp"
+
+namespace
+{
+  const char* filter = nullptr;
+  bool failed = false;
+
+  template<typename F>
+  void report(const char* name, F f)
+  {
+    if (filter && !std::strstr(name, filter))
+      return;
+
+    heap::usage before{};
+    const bench::timed timing = bench::measure(f, [&before] { before = heap::total(); });
+    const heap::usage after = heap::total();
+
+    std::printf(
+      "{\"name\":\"%s\",\"ns_per_op\":%.1f,\"allocs_per_op\":%.2f,\"bytes_per_op\":%.1f,\"iterations\":%llu}\n",
+      name,
+      timing.ns_per_call,
+      double(after.allocations - before.allocations) / timing.calls,
+      double(after.bytes - before.bytes) / timing.calls,
+      (unsigned long long)timing.calls
+    );
+  }
+
+  void check(const bool good, const char* what)
+  {
+    if (!good)
+    {
+      std::fprintf(stderr, "%s failed\n", what);
+      failed = true;
+    }
+  }
+
+  void write_varint(byte_stream& out, std::uint64_t value)
+  {
+    for ( ; 0x80 <= value; value >>= 7)
+      out.put(std::uint8_t(value | 0x80));
+    out.put(std::uint8_t(value));
+  }
+
+  void write_field(byte_stream& out, const unsigned field, span<const std::uint8_t> bytes)
+  {
+    write_varint(out, (field << 3) | 2);
+    write_varint(out, bytes.size());
+    out.write(bytes);
+  }
+
+  //! `ecdh_session` as sent by the device: two 33-byte keys.
+  byte_slice ecdh_session_bytes()
+  {
+    std::uint8_t key[33];
+    for (unsigned i = 0; i < sizeof(key); ++i)
+      key[i] = std::uint8_t(i * 7);
+
+    byte_stream out{};
+    write_field(out, 1, {key, sizeof(key)});
+    write_field(out, 2, {key, sizeof(key)});
+    return byte_slice{std::move(out)};
+  }
+
+  //! `public_key` as sent by the device, with the fields macer skips.
+  byte_slice public_key_bytes()
+  {
+    std::uint8_t chain_code[32];
+    std::uint8_t key[33];
+    std::memset(chain_code, 0x5a, sizeof(chain_code));
+    for (unsigned i = 0; i < sizeof(key); ++i)
+      key[i] = std::uint8_t(i * 3);
+
+    byte_stream node{};
+    write_varint(node, (1 << 3) | 0);
+    write_varint(node, 5); // depth
+    write_varint(node, (2 << 3) | 0);
+    write_varint(node, 0x8d3b1a2c); // fingerprint
+    write_varint(node, (3 << 3) | 0);
+    write_varint(node, 0x80000000 | 17); // child_num
+    write_field(node, 4, {chain_code, sizeof(chain_code)});
+    write_field(node, 6, {key, sizeof(key)});
+    const byte_slice node_bytes{std::move(node)};
+
+    static constexpr const char xpub[] =
+      "xpub6FHa3pjLCk84BayeJxFW2SP4XRrFd1JYnxeLeU8EqN3vDfZmbqBqaGJAyiLjTAwm6ZLRQUMv1ZACTj37sR62cfN7fe5JnJ7dh8zL4fiyLHV";
+
+    byte_stream out{};
+    write_field(out, 1, {node_bytes.data(), node_bytes.size()});
+    write_field(out, 2, {reinterpret_cast<const std::uint8_t*>(xpub), sizeof(xpub) - 1});
+    return byte_slice{std::move(out)};
+  }
+
+  trezor::get_ecdh_session ecdh_request()
+  {
+    host_info info{};
+    info.host = "server.example.com";
+    info.user = "root";
+    trezor::get_ecdh_session out{trezor::make_identity(info), "curve25519"};
+    for (unsigned i = 0; i < sizeof(out.peer_key.data); ++i)
+      out.peer_key.data[i] = std::uint8_t(i);
+    return out;
+  }
+
+  void protobuf_benchmarks()
+  {
+    const trezor::get_ecdh_session request = ecdh_request();
+    report("protobuf/write/get_ecdh_session", [&request] {
+      byte_chain bytes{};
+      bench::do_not_optimize(wire::protobuf::to_bytes(bytes, request));
+      bench::do_not_optimize(bytes.size());
+    });
+
+    const trezor::get_public_key key_request{"curve25519", {{trezor::hardened_path | 17, 1, 2, 3, 4}}};
+    report("protobuf/write/get_public_key", [&key_request] {
+      byte_chain bytes{};
+      bench::do_not_optimize(wire::protobuf::to_bytes(bytes, key_request));
+      bench::do_not_optimize(bytes.size());
+    });
+
+    const byte_slice session = ecdh_session_bytes();
+    check(bool(wire::protobuf::from_bytes<trezor::ecdh_session>(session.clone())), "ecdh_session decode");
+    report("protobuf/read/ecdh_session", [&session] {
+      const auto message = wire::protobuf::from_bytes<trezor::ecdh_session>(session.clone());
+      bench::do_not_optimize(message->secret_key.data[0]);
+    });
+
+    const byte_slice public_key = public_key_bytes();
+    check(bool(wire::protobuf::from_bytes<trezor::public_key>(public_key.clone())), "public_key decode");
+    report("protobuf/read/public_key", [&public_key] {
+      const auto message = wire::protobuf::from_bytes<trezor::public_key>(public_key.clone());
+      bench::do_not_optimize(message->node.public_key.data[0]);
+    });
+  }
+
+  void framing_benchmarks()
+  {
+    byte_chain payload{};
+    check(!wire::protobuf::to_bytes(payload, ecdh_request()), "get_ecdh_session encode");
+    std::vector<byte_slice> segments{};
+    for (const byte_slice& segment : payload)
+      segments.push_back(segment.clone());
+
+    report("framing/pack/get_ecdh_session", [&segments] {
+      byte_chain bytes{};
+      for (const byte_slice& segment : segments)
+        bytes.push_back(segment.clone());
+
+      trezor::framing::report buffer;
+      trezor::framing::pack_first(buffer, trezor::message_id::get_ecdh_session, bytes);
+      bench::do_not_optimize(buffer);
+      while (!bytes.empty())
+      {
+        trezor::framing::pack_next(buffer, bytes);
+        bench::do_not_optimize(buffer);
+      }
+    });
+
+    std::vector<std::uint8_t> reports{};
+    {
+      byte_chain bytes{};
+      for (const byte_slice& segment : segments)
+        bytes.push_back(segment.clone());
+
+      trezor::framing::report buffer;
+      trezor::framing::pack_first(buffer, trezor::message_id::get_ecdh_session, bytes);
+      reports.insert(reports.end(), buffer, buffer + sizeof(buffer));
+      while (!bytes.empty())
+      {
+        trezor::framing::pack_next(buffer, bytes);
+        reports.insert(reports.end(), buffer, buffer + sizeof(buffer));
+      }
+    }
+
+    report("framing/unpack/get_ecdh_session", [&reports] {
+      using report_ptr = const trezor::framing::report*;
+      report_ptr next = reinterpret_cast<report_ptr>(reports.data());
+
+      byte_stream unpacked{};
+      std::uint32_t remaining = 0;
+      const expect<std::uint16_t> id = trezor::framing::unpack_first(*next, unpacked, remaining);
+      while (id && remaining)
+        trezor::framing::unpack_next(*++next, unpacked, remaining);
+      bench::do_not_optimize(unpacked.size());
+    });
+  }
+
+  void buffer_benchmarks()
+  {
+    std::uint8_t chunk[64];
+    std::memset(chunk, 0xa5, sizeof(chunk));
+
+    report("byte_stream/write/64x64", [&chunk] {
+      byte_stream out{};
+      for (unsigned i = 0; i < 64; ++i)
+        out.write({chunk, sizeof(chunk)});
+      bench::do_not_optimize(out.size());
+    });
+
+    report("byte_stream/put/4096", [] {
+      byte_stream out{};
+      for (unsigned i = 0; i < 4096; ++i)
+        out.put(std::uint8_t(i));
+      bench::do_not_optimize(out.size());
+    });
+
+    std::vector<std::uint8_t> data(4096, 0x3c);
+    const byte_slice slice{{data.data(), data.size()}};
+    report("byte_slice/clone", [&slice] {
+      byte_slice copy = slice.clone();
+      bench::do_not_optimize(copy.data());
+    });
+
+    report("byte_slice/get_slice", [&slice] {
+      byte_slice part = slice.get_slice(16, 48);
+      bench::do_not_optimize(part.data());
+    });
+
+    report("byte_slice/take_slice/64x64", [&slice] {
+      byte_slice copy = slice.clone();
+      for (unsigned i = 0; i < 64; ++i)
+      {
+        byte_slice part = copy.take_slice(64);
+        bench::do_not_optimize(part.data());
+      }
+    });
+  }
+
+  void crypto_benchmarks()
+  {
+    std::vector<std::uint8_t> data(4096, 0x42);
+    unsigned char digest[crypto_hash_sha256_BYTES];
+    report("sha256/64", [&] {
+      crypto_hash_sha256(digest, data.data(), 64);
+      bench::do_not_optimize(digest);
+    });
+    report("sha256/4096", [&] {
+      crypto_hash_sha256(digest, data.data(), data.size());
+      bench::do_not_optimize(digest);
+    });
+
+    std::uint8_t entropy[32];
+    for (unsigned i = 0; i < sizeof(entropy); ++i)
+      entropy[i] = std::uint8_t(i * 11);
+    const byte_slice secret{{entropy, sizeof(entropy)}};
+    check(bool(bip39::encode(secret.clone())), "bip39::encode");
+    report("bip39/encode/24", [&secret] {
+      const expect<byte_slice> text = bip39::encode(secret.clone());
+      bench::do_not_optimize(text->data());
+    });
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  if (1 < argc)
+    filter = argv[1];
+
+  protobuf_benchmarks();
+  framing_benchmarks();
+  buffer_benchmarks();
+  crypto_benchmarks();
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,164 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/* Steady-state heap traffic of deriving one secret, by phase: protobuf
+   encode of `get_ecdh_session` and decode of `ecdh_session`, the session
+   hash, `--software` derivation and BIP-39 encoding. Fails when the
+   allocations per secret exceed a budget. Built with the counting
+   allocator (`MACER_HEAP_PROFILE`) whatever `./configure` chose.
+   Usage: `bench_heap [budget [secrets]]`. */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "bench/bench.hpp"
+#include "byte_chain.hpp"
+#include "crypto/bip39/encoder.hpp"
+#include "heap.hpp"
+#include "host_info.hpp"
+#include "timing.hpp"
+#include "trezor/crypto.hpp"
+#include "trezor/identity.hpp"
+#include "trezor/software.hpp"
+#include "wire/protobuf.hpp"
+
+namespace
+{
+  constexpr const char mnemonic[] =
+    "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about";
+
+  /* Allocations per secret at the time of writing were 14; the default
+     budget leaves a little room for allocator or library differences. */
+  constexpr const unsigned long default_budget = 16;
+
+  //! `ecdh_session` as sent by the device: two 33-byte fields.
+  byte_slice ecdh_response()
+  {
+    std::uint8_t bytes[2 + 33 + 2 + 33] = {};
+    bytes[0] = 0x0a;
+    bytes[1] = 33;
+    bytes[2] = 0x01; // device prefix, dropped by macer
+    for (unsigned i = 3; i < 35; ++i)
+      bytes[i] = std::uint8_t(i);
+    bytes[35] = 0x12;
+    bytes[36] = 33;
+    return byte_slice{{bytes, sizeof(bytes)}};
+  }
+
+  //! One secret, charging each step to the phase `macer` uses.
+  bool derive(const slip10::seed& seed, const host_info& info, const byte_slice& response)
+  {
+    {
+      const timing::scope encoding{timing::phase::protobuf};
+      trezor::get_ecdh_session request{trezor::make_identity(info), "curve25519"};
+      byte_chain bytes{};
+      if (wire::protobuf::to_bytes(bytes, request))
+        return false;
+      bench::do_not_optimize(bytes.size());
+    }
+
+    expect<trezor::ecdh_session> session{common_error::invalid_argument};
+    {
+      const timing::scope decoding{timing::phase::protobuf};
+      session = wire::protobuf::from_bytes<trezor::ecdh_session>(response.clone());
+      if (!session)
+        return false;
+    }
+
+    auto key = as_byte_span(session->secret_key);
+    key.remove_prefix(1);
+    const expect<byte_slice> hashed = timing::measure(timing::phase::hashing, [key] { return trezor::session_secret(key); });
+    if (!hashed)
+      return false;
+
+    const expect<byte_slice> secret = timing::measure(timing::phase::software, [&] { return trezor::software::run(seed, info); });
+    if (!secret)
+      return false;
+
+    const expect<byte_slice> text = timing::measure(timing::phase::encoding, [&] { return bip39::encode(secret->get_slice(0, 32)); });
+    return bool(text);
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  static_assert(heap::profiled(), "bench_heap needs MACER_HEAP_PROFILE");
+
+  const unsigned long budget = 1 < argc ? std::strtoul(argv[1], nullptr, 10) : default_budget;
+  const unsigned long count = 2 < argc ? std::strtoul(argv[2], nullptr, 10) : 256;
+
+  const expect<slip10::seed> seed = trezor::software::make_seed({mnemonic, sizeof(mnemonic) - 1}, nullptr);
+  if (!seed || !count)
+  {
+    std::fprintf(stderr, "make_seed failed\n");
+    return 1;
+  }
+
+  host_info info{};
+  info.host = "host.example.com";
+  info.user = "user";
+  const byte_slice response = ecdh_response();
+
+  // warm lazy initialization (SIMD dispatch, static tables)
+  for (unsigned i = 0; i < 16; ++i)
+  {
+    if (!derive(*seed, info, response))
+    {
+      std::fprintf(stderr, "derivation failed\n");
+      return 1;
+    }
+  }
+
+  heap::usage before[std::size_t(timing::phase::count) + 1];
+  for (std::size_t i = 0; i <= std::size_t(timing::phase::count); ++i)
+    before[i] = heap::get(timing::phase(i));
+
+  for (unsigned long i = 0; i < count; ++i)
+    derive(*seed, info, response);
+
+  std::uint64_t allocations = 0;
+  std::printf("%-18s %14s %14s\n", "per secret", "allocs", "bytes");
+  for (std::size_t i = 0; i <= std::size_t(timing::phase::count); ++i)
+  {
+    const heap::usage after = heap::get(timing::phase(i));
+    const std::uint64_t calls = after.allocations - before[i].allocations;
+    if (!calls)
+      continue;
+    allocations += calls;
+    std::printf("%-18s %14.2f %14.1f\n", timing::name(timing::phase(i)), double(calls) / count, double(after.bytes - before[i].bytes) / count);
+  }
+
+  const double per_secret = double(allocations) / count;
+  std::printf("%-18s %14.2f (budget %lu)\n", "total", per_secret, budget);
+  if (budget < per_secret)
+  {
+    std::fprintf(stderr, "allocations per secret over budget\n");
+    return 1;
+  }
+  return 0;
+}
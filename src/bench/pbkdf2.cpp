@@ -0,0 +1,175 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/* Compares the PBKDF2-HMAC-SHA512 kernels against a naive HMAC-per-iteration
+   reference, then times BIP-39 seed derivation (2048 iterations). */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "bench/bench.hpp"
+#include "crypto/hmac_sha512.h"
+#include "crypto/pbkdf2.h"
+#include "crypto/runtime.h"
+#include "crypto/sha512_impl.h"
+
+namespace
+{
+  constexpr const std::uint64_t bip39_iterations = 2048;
+
+  //! RFC 8018 as written, re-keying HMAC every iteration.
+  void naive(unsigned char* out, const std::size_t outlen, const std::string& pass, const std::string& salt, const std::uint64_t iterations)
+  {
+    const auto* key = reinterpret_cast<const unsigned char*>(pass.data());
+    for (std::size_t i = 0; i * 64 < outlen; ++i)
+    {
+      std::string block = salt;
+      block.push_back(char((i + 1) >> 24));
+      block.push_back(char((i + 1) >> 16));
+      block.push_back(char((i + 1) >> 8));
+      block.push_back(char(i + 1));
+
+      unsigned char u[64];
+      unsigned char t[64];
+      crypto_auth_hmacsha512(u, reinterpret_cast<const unsigned char*>(block.data()), block.size(), key, pass.size());
+      std::memcpy(t, u, sizeof(t));
+      for (std::uint64_t j = 1; j < iterations; ++j)
+      {
+        crypto_auth_hmacsha512(u, u, sizeof(u), key, pass.size());
+        for (unsigned k = 0; k < 64; ++k)
+          t[k] ^= u[k];
+      }
+      std::memcpy(out + i * 64, t, std::min(std::size_t(64), outlen - i * 64));
+    }
+  }
+
+  using derive_x4 = void(*)(unsigned char* const*, std::size_t, const unsigned char* const*, const std::size_t*, const unsigned char* const*, const std::size_t*, std::uint64_t);
+
+  void serial_x4(unsigned char* const* out, std::size_t outlen, const unsigned char* const* pass, const std::size_t* passlen, const unsigned char* const* salt, const std::size_t* saltlen, std::uint64_t iterations)
+  {
+    for (unsigned i = 0; i < 4; ++i)
+      crypto_pbkdf2_sha512(out[i], outlen, pass[i], passlen[i], salt[i], saltlen[i], iterations);
+  }
+
+  void dispatch_x4(unsigned char* const* out, std::size_t outlen, const unsigned char* const* pass, const std::size_t* passlen, const unsigned char* const* salt, const std::size_t* saltlen, std::uint64_t iterations)
+  {
+    crypto_pbkdf2_sha512_x4(out, outlen, pass, passlen, salt, saltlen, iterations);
+  }
+
+#if defined(__x86_64__) || defined(__i386__)
+  void avx2_x4(unsigned char* const* out, std::size_t outlen, const unsigned char* const* pass, const std::size_t* passlen, const unsigned char* const* salt, const std::size_t* saltlen, std::uint64_t iterations)
+  {
+    crypto_pbkdf2_sha512_x4_avx2(out, outlen, pass, passlen, salt, saltlen, iterations);
+  }
+#endif
+}
+
+int main()
+{
+  struct kernel
+  {
+    const char* name;
+    derive_x4 derive;
+    int (*available)();
+  };
+  static constexpr const kernel kernels[] = {
+    {"serial", serial_x4, nullptr},
+#if defined(__x86_64__) || defined(__i386__)
+    {"avx2_x4", avx2_x4, crypto_runtime_has_avx2},
+#endif
+    {"dispatch_x4", dispatch_x4, nullptr}
+  };
+
+  // candidate passphrases for one mnemonic; lengths differ per lane
+  const std::string mnemonic = "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about";
+  const std::string salts[4] = {"mnemonic", "mnemonicTREZOR", "mnemonic" + std::string(150, 'x'), "mnemonicpassphrase"};
+  const std::string passes[4] = {mnemonic, mnemonic, std::string(200, 'p'), "short"};
+
+  const unsigned char* pass[4];
+  const unsigned char* salt[4];
+  std::size_t passlen[4];
+  std::size_t saltlen[4];
+  for (unsigned i = 0; i < 4; ++i)
+  {
+    pass[i] = reinterpret_cast<const unsigned char*>(passes[i].data());
+    passlen[i] = passes[i].size();
+    salt[i] = reinterpret_cast<const unsigned char*>(salts[i].data());
+    saltlen[i] = salts[i].size();
+  }
+
+  int rc = 0;
+  for (const kernel& k : kernels)
+  {
+    if (k.available && !k.available())
+    {
+      std::printf("%-44s unavailable on this CPU\n", k.name);
+      continue;
+    }
+
+    for (const std::uint64_t iterations : {std::uint64_t(1), std::uint64_t(2), bip39_iterations})
+    {
+      for (const std::size_t outlen : {std::size_t(64), std::size_t(100)})
+      {
+        unsigned char expected[4][128];
+        unsigned char actual[4][128];
+        unsigned char* out[4] = {actual[0], actual[1], actual[2], actual[3]};
+        for (unsigned i = 0; i < 4; ++i)
+          naive(expected[i], outlen, passes[i], salts[i], iterations);
+        k.derive(out, outlen, pass, passlen, salt, saltlen, iterations);
+        for (unsigned i = 0; i < 4; ++i)
+        {
+          if (std::memcmp(expected[i], actual[i], outlen) != 0)
+          {
+            std::fprintf(stderr, "%s: lane %u differs from reference (%llu iterations, %zu bytes)\n", k.name, i, (unsigned long long)iterations, outlen);
+            rc = 1;
+          }
+        }
+      }
+    }
+  }
+  if (rc)
+    return rc;
+
+  {
+    unsigned char seed[64];
+    bench::run("pbkdf2_sha512/naive/bip39", [&] () { naive(seed, sizeof(seed), passes[1], salts[1], bip39_iterations); bench::do_not_optimize(seed); });
+  }
+  for (const kernel& k : kernels)
+  {
+    if (k.available && !k.available())
+      continue;
+
+    unsigned char seeds[4][64];
+    unsigned char* out[4] = {seeds[0], seeds[1], seeds[2], seeds[3]};
+    const std::string name = "pbkdf2_sha512_x4/" + std::string{k.name} + "/bip39";
+    const double ns = bench::run(name.c_str(), [&] () { k.derive(out, 64, pass, passlen, salt, saltlen, bip39_iterations); bench::do_not_optimize(seeds); });
+    std::printf("%-44s %12.1f ns/seed\n", "", ns / 4);
+  }
+  return 0;
+}
@@ -0,0 +1,185 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/* Compares each SHA-256 block kernel against the portable (`cp`) kernel, and
+   the multi-buffer kernels against hashing the same messages one at a time. */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "crypto/runtime.h"
+#include "crypto/sha256.h"
+#include "crypto/sha256_impl.h"
+
+namespace
+{
+  bool same_output(const crypto_hash_sha256_implementation& impl, const std::vector<std::uint8_t>& data)
+  {
+    std::size_t count = 0;
+    const crypto_hash_sha256_implementation* const reference = crypto_hash_sha256_implementations(&count);
+
+    for (std::size_t blocks = 1; blocks <= data.size() / 64; blocks *= 2)
+    {
+      std::uint32_t expected[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+      std::uint32_t actual[8];
+      std::memcpy(actual, expected, sizeof(actual));
+      reference->blocks(expected, data.data(), blocks);
+      impl.blocks(actual, data.data(), blocks);
+      if (std::memcmp(expected, actual, sizeof(actual)) != 0)
+        return false;
+    }
+    return true;
+  }
+
+  using hash_many = void(*)(unsigned char (*)[crypto_hash_sha256_BYTES], const unsigned char* const*, const unsigned long long*);
+
+  void serial8(unsigned char (*out)[crypto_hash_sha256_BYTES], const unsigned char* const* in, const unsigned long long* inlen)
+  {
+    for (unsigned i = 0; i < 8; ++i)
+      crypto_hash_sha256(out[i], in[i], inlen[i]);
+  }
+
+  void x8(unsigned char (*out)[crypto_hash_sha256_BYTES], const unsigned char* const* in, const unsigned long long* inlen)
+  {
+    crypto_hash_sha256_x8(out, in, inlen);
+  }
+
+#if defined(__x86_64__) || defined(__i386__)
+  void sse2_x4(unsigned char (*out)[crypto_hash_sha256_BYTES], const unsigned char* const* in, const unsigned long long* inlen)
+  {
+    crypto_hash_sha256_x4_sse2(out, in, inlen);
+    crypto_hash_sha256_x4_sse2(out + 4, in + 4, inlen + 4);
+  }
+
+  void avx2_x8(unsigned char (*out)[crypto_hash_sha256_BYTES], const unsigned char* const* in, const unsigned long long* inlen)
+  {
+    crypto_hash_sha256_x8_avx2(out, in, inlen);
+  }
+#endif
+
+  int bench_multi_buffer(const std::vector<std::uint8_t>& data)
+  {
+    struct kernel
+    {
+      const char* name;
+      hash_many hash;
+      int (*available)();
+    };
+    static constexpr const kernel kernels[] = {
+      {"serial", serial8, nullptr},
+#if defined(__x86_64__) || defined(__i386__)
+      {"sse2_x4", sse2_x4, nullptr},
+      {"avx2_x8", avx2_x8, crypto_runtime_has_avx2},
+#endif
+      {"dispatch_x8", x8, nullptr}
+    };
+
+    int rc = 0;
+    for (const std::size_t length : {std::size_t(32), std::size_t(47), std::size_t(100)})
+    {
+      const unsigned char* in[8];
+      unsigned long long inlen[8];
+      for (unsigned i = 0; i < 8; ++i)
+      {
+        in[i] = data.data() + i * 128;
+        inlen[i] = length + i; // mixed lengths cross the one/two block boundary
+      }
+
+      unsigned char expected[8][crypto_hash_sha256_BYTES];
+      serial8(expected, in, inlen);
+      for (const kernel& k : kernels)
+      {
+        if (k.available && !k.available())
+        {
+          std::printf("%-44s unavailable on this CPU\n", k.name);
+          continue;
+        }
+
+        unsigned char out[8][crypto_hash_sha256_BYTES];
+        k.hash(out, in, inlen);
+        if (std::memcmp(expected, out, sizeof(out)) != 0)
+        {
+          std::fprintf(stderr, "%s: output differs from serial hashing\n", k.name);
+          rc = 1;
+          continue;
+        }
+
+        const std::string name = "sha256_x8/" + std::string{k.name} + "/" + std::to_string(length) + "+";
+        bench::run(name.c_str(), [&] () { k.hash(out, in, inlen); bench::do_not_optimize(out); });
+      }
+    }
+    return rc;
+  }
+}
+
+int main()
+{
+  std::vector<std::uint8_t> data(64 * 1024);
+  for (std::size_t i = 0; i < data.size(); ++i)
+    data[i] = std::uint8_t(i * 131 + 7);
+
+  std::size_t count = 0;
+  const crypto_hash_sha256_implementation* const impls = crypto_hash_sha256_implementations(&count);
+  std::printf("selected kernel: %s\n", crypto_hash_sha256_current_implementation()->name);
+
+  int rc = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const crypto_hash_sha256_implementation& impl = impls[i];
+    if (!impl.available())
+    {
+      std::printf("%-44s unavailable on this CPU\n", impl.name);
+      continue;
+    }
+    if (!same_output(impl, data))
+    {
+      std::fprintf(stderr, "%s: output differs from portable kernel\n", impl.name);
+      rc = 1;
+      continue;
+    }
+
+    for (const std::size_t blocks : {std::size_t(1), std::size_t(16), data.size() / 64})
+    {
+      std::uint32_t state[8] = {};
+      const std::string name = "sha256_blocks/" + std::string{impl.name} + "/" + std::to_string(blocks * 64);
+      bench::run(name.c_str(), [&] () { impl.blocks(state, data.data(), blocks); bench::do_not_optimize(state); }, blocks * 64);
+    }
+  }
+
+  // end-to-end with dispatch, sizes of the macer inputs (URI, ECDH secret)
+  for (const std::size_t length : {std::size_t(32), std::size_t(64), std::size_t(1024)})
+  {
+    unsigned char hash[crypto_hash_sha256_BYTES];
+    const std::string name = "crypto_hash_sha256/" + std::to_string(length);
+    bench::run(name.c_str(), [&] () { crypto_hash_sha256(hash, data.data(), length); bench::do_not_optimize(hash); }, length);
+  }
+  return bench_multi_buffer(data) | rc;
+}
@@ -0,0 +1,303 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/* Checks every X25519 kernel against the RFC 7748 section 5.2 vectors
+   (including the iterated ones) and against each other on pseudo-random
+   inputs, then times a single ladder, batches of four, and the fixed-base
+   comb used for public keys. */
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "crypto/runtime.h"
+#include "crypto/x25519.h"
+#include "crypto/x25519_impl.h"
+
+namespace
+{
+  using point = unsigned char[32];
+
+  struct vector
+  {
+    const char* scalar;
+    const char* u;
+    const char* out;
+  };
+
+  constexpr const vector rfc7748[] = {
+    {
+      "a546e36bf0527c9d3b16154b82465edd62144c0ac1fc5a18506a2244ba449ac4",
+      "e6db6867583030db3594c1a424b15f7c726624ec26b3353b10a903a6d0ab1c4c",
+      "c3da55379de9c6908e94ea4df28d084f32eccf03491c71f754b4075577a28552"
+    },
+    {
+      "4b66e9d4d1b4673c5ad22691957d6af5c11b6421e0ea01d42ca4169e7918ba0d",
+      "e5210f12786811d3f4b7959d0538ae2c31dbe7106fc03c3efc4cd549c715a413",
+      "95cbde9476e8907d7aade45cb4b873f88b595a68799fa152e6f8f7647aac7957"
+    }
+  };
+
+  //! Output of the iterated test (k = u = 9) after 1 and 1000 rounds.
+  constexpr const char* const iterated_1 = "422c8e7a6227d7bca1350b3e2bb7279f7897b87bb6854b783c60e80311ae3079";
+  constexpr const char* const iterated_1000 = "684cf59ba83309552800ef566f2f4d3c1c3887c49360e3875f2eb94d99532c51";
+
+  void from_hex(point out, const char* hex)
+  {
+    for (unsigned i = 0; i < 32; ++i)
+    {
+      unsigned value = 0;
+      std::sscanf(hex + i * 2, "%2x", &value);
+      out[i] = static_cast<unsigned char>(value);
+    }
+  }
+
+  bool equal_hex(const point value, const char* hex)
+  {
+    point expected;
+    from_hex(expected, hex);
+    return std::memcmp(value, expected, sizeof(expected)) == 0;
+  }
+
+  //! Single ladder signature, so the x4 kernels can be checked like the others.
+  using scalarmult = void(*)(unsigned char*, const unsigned char*, const unsigned char*);
+
+  bool check_vectors(const char* name, const scalarmult mult)
+  {
+    bool good = true;
+    for (const vector& v : rfc7748)
+    {
+      point k, u, out;
+      from_hex(k, v.scalar);
+      from_hex(u, v.u);
+      mult(out, k, u);
+      good &= equal_hex(out, v.out);
+    }
+
+    point k{9}, u{9}, out;
+    for (unsigned i = 1; i <= 1000; ++i)
+    {
+      mult(out, k, u);
+      std::memcpy(u, k, sizeof(u));
+      std::memcpy(k, out, sizeof(k));
+      if (i == 1)
+        good &= equal_hex(k, iterated_1);
+    }
+    good &= equal_hex(k, iterated_1000);
+
+    if (!good)
+      std::fprintf(stderr, "%s: RFC 7748 vectors failed\n", name);
+    return good;
+  }
+
+  //! Deterministic xorshift fill; the high bit of `u` is set to test masking.
+  void fill(point out, std::uint64_t& state)
+  {
+    for (unsigned i = 0; i < 32; ++i)
+    {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      out[i] = static_cast<unsigned char>(state);
+    }
+  }
+
+#if defined(__x86_64__)
+  //! Runs one ladder in lane 0 and a different ladder in the other lanes.
+  void avx2_lane0(unsigned char* q, const unsigned char* n, const unsigned char* p)
+  {
+    static const unsigned char other[32] = {9};
+    const unsigned char* const scalars[4] = {n, other, n, other};
+    const unsigned char* const points[4] = {p, other, other, p};
+    unsigned char out[4][32];
+    crypto_scalarmult_curve25519_x4_avx2(out, scalars, points);
+    std::memcpy(q, out[0], 32);
+  }
+#endif
+
+  void dispatch_x4_lane0(unsigned char* q, const unsigned char* n, const unsigned char* p)
+  {
+    const unsigned char* const scalars[4] = {n, n, n, n};
+    const unsigned char* const points[4] = {p, p, p, p};
+    unsigned char out[4][32];
+    crypto_scalarmult_curve25519_x4(out, scalars, points);
+    std::memcpy(q, out[0], 32);
+  }
+
+  int bench_base(const crypto_scalarmult_curve25519_implementation& reference)
+  {
+    static constexpr const unsigned char basepoint[32] = {9};
+    static constexpr const std::size_t keys = 256;
+
+    std::uint64_t state = 0x243f6a8885a308d3;
+    std::vector<std::array<unsigned char, 32>> scalars(keys);
+    std::vector<const unsigned char*> n(keys);
+    for (std::size_t i = 0; i < keys; ++i)
+    {
+      fill(scalars[i].data(), state);
+      n[i] = scalars[i].data();
+    }
+
+    std::vector<std::array<unsigned char, 32>> out(keys);
+    auto* const q = reinterpret_cast<unsigned char (*)[32]>(out.data());
+    if (crypto_scalarmult_curve25519_base_many(q, n.data(), keys) != 0)
+    {
+      std::fprintf(stderr, "base_many: unexpected all-zero key\n");
+      return 1;
+    }
+    for (std::size_t i = 0; i < keys; ++i)
+    {
+      point expected;
+      reference.scalarmult(expected, n[i], basepoint);
+      if (std::memcmp(expected, out[i].data(), sizeof(expected)) != 0)
+      {
+        std::fprintf(stderr, "base_many: output differs from %s ladder\n", reference.name);
+        return 1;
+      }
+    }
+
+    point single;
+    const std::string ladder = "x25519_base/" + std::string{reference.name} + "_ladder";
+    bench::run(ladder.c_str(), [&] () { reference.scalarmult(single, n[0], basepoint); bench::do_not_optimize(single); });
+    for (const std::size_t count : {std::size_t(1), std::size_t(4), std::size_t(32), keys})
+    {
+      const std::string name = "x25519_base/comb/" + std::to_string(count);
+      const double ns = bench::run(name.c_str(), [&] () { crypto_scalarmult_curve25519_base_many(q, n.data(), count); bench::do_not_optimize(out); });
+      std::printf("%-44s %12.1f ns/key\n", "", ns / count);
+    }
+    return 0;
+  }
+
+  int bench_x4(const crypto_scalarmult_curve25519_implementation& reference)
+  {
+    struct kernel
+    {
+      const char* name;
+      void (*mult)(unsigned char (*)[32], const unsigned char* const*, const unsigned char* const*);
+      int (*available)();
+    };
+    static constexpr const kernel kernels[] = {
+#if defined(__x86_64__)
+      {"avx2_x4", crypto_scalarmult_curve25519_x4_avx2, crypto_runtime_has_avx2},
+#endif
+      {"dispatch_x4", [] (unsigned char (*q)[32], const unsigned char* const* n, const unsigned char* const* p)
+        { crypto_scalarmult_curve25519_x4(q, n, p); }, nullptr}
+    };
+
+    std::uint64_t state = 0x9e3779b97f4a7c15;
+    point scalars[4], points[4];
+    const unsigned char* n[4];
+    const unsigned char* p[4];
+    for (unsigned i = 0; i < 4; ++i)
+    {
+      fill(scalars[i], state);
+      fill(points[i], state);
+      n[i] = scalars[i];
+      p[i] = points[i];
+    }
+
+    int rc = 0;
+    for (const kernel& k : kernels)
+    {
+      if (k.available && !k.available())
+      {
+        std::printf("%-44s unavailable on this CPU\n", k.name);
+        continue;
+      }
+
+      bool good = true;
+      for (unsigned round = 0; round < 64 && good; ++round)
+      {
+        unsigned char out[4][32];
+        k.mult(out, n, p);
+        for (unsigned i = 0; i < 4; ++i)
+        {
+          point expected;
+          reference.scalarmult(expected, n[i], p[i]);
+          good &= std::memcmp(expected, out[i], sizeof(expected)) == 0;
+          std::memcpy(points[i], out[i], sizeof(points[i])); // chain rounds
+          fill(scalars[i], state);
+        }
+      }
+      if (!good)
+      {
+        std::fprintf(stderr, "%s: output differs from %s kernel\n", k.name, reference.name);
+        rc = 1;
+        continue;
+      }
+
+      unsigned char out[4][32];
+      const std::string name = "x25519_x4/" + std::string{k.name};
+      const double ns = bench::run(name.c_str(), [&] () { k.mult(out, n, p); bench::do_not_optimize(out); });
+      std::printf("%-44s %12.1f ns/ladder\n", "", ns / 4);
+    }
+    return rc;
+  }
+}
+
+int main()
+{
+  std::size_t count = 0;
+  const crypto_scalarmult_curve25519_implementation* const impls = crypto_scalarmult_curve25519_implementations(&count);
+  std::printf("selected kernel: %s\n", crypto_scalarmult_curve25519_current_implementation()->name);
+
+  int rc = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const crypto_scalarmult_curve25519_implementation& impl = impls[i];
+    if (!impl.available())
+    {
+      std::printf("%-44s unavailable on this CPU\n", impl.name);
+      continue;
+    }
+    if (!check_vectors(impl.name, impl.scalarmult))
+    {
+      rc = 1;
+      continue;
+    }
+
+    point k{}, u{}, out;
+    std::uint64_t state = 0x0123456789abcdef;
+    fill(k, state);
+    fill(u, state);
+    const std::string name = "x25519/" + std::string{impl.name};
+    bench::run(name.c_str(), [&] () { impl.scalarmult(out, k, u); bench::do_not_optimize(out); });
+  }
+
+#if defined(__x86_64__)
+  if (crypto_runtime_has_avx2() && !check_vectors("avx2_x4", avx2_lane0))
+    rc = 1;
+#endif
+  if (!check_vectors("dispatch_x4", dispatch_x4_lane0))
+    rc = 1;
+
+  return bench_base(impls[count - 1]) | bench_x4(impls[count - 1]) | rc;
+}
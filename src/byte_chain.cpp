@@ -0,0 +1,157 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "byte_chain.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <sys/uio.h>
+#include <utility>
+
+namespace
+{
+#ifdef IOV_MAX
+  constexpr const std::size_t max_iov = IOV_MAX;
+#else
+  constexpr const std::size_t max_iov = 1024; // Linux UIO_MAXIOV
+#endif
+}
+
+byte_chain::byte_chain(byte_chain&& rhs) noexcept
+  : segments_(std::move(rhs.segments_)), size_(rhs.size_), offset_(rhs.offset_)
+{
+  rhs.clear();
+}
+
+byte_chain& byte_chain::operator=(byte_chain&& rhs) noexcept
+{
+  if (this != std::addressof(rhs))
+  {
+    segments_ = std::move(rhs.segments_);
+    size_ = rhs.size_;
+    offset_ = rhs.offset_;
+    rhs.clear();
+  }
+  return *this;
+}
+
+void byte_chain::clear() noexcept
+{
+  segments_.clear();
+  size_ = 0;
+  offset_ = 0;
+}
+
+void byte_chain::push_back(byte_slice segment)
+{
+  if (segment.empty())
+    return;
+
+  // Re-use space of released segments before growing the list
+  if (offset_ && segments_.size() == segments_.capacity())
+  {
+    segments_.erase(segments_.begin(), segments_.begin() + offset_);
+    offset_ = 0;
+  }
+
+  const std::size_t length = segment.size();
+  segments_.push_back(std::move(segment));
+  size_ += length;
+}
+
+void byte_chain::append(byte_chain&& source)
+{
+  segments_.reserve(segment_count() + source.segment_count());
+  for (auto segment = source.segments_.begin() + source.offset_; segment != source.segments_.end(); ++segment)
+    push_back(std::move(*segment));
+  source.clear();
+}
+
+std::size_t byte_chain::copy_prefix(span<std::uint8_t> dest) const noexcept
+{
+  const std::size_t total = dest.size();
+  for (const byte_slice& segment : *this)
+  {
+    if (dest.empty())
+      break;
+    const std::size_t next = std::min(dest.size(), segment.size());
+    std::memcpy(dest.data(), segment.data(), next);
+    dest.remove_prefix(next);
+  }
+  return total - dest.size();
+}
+
+std::size_t byte_chain::remove_prefix(std::size_t max_bytes) noexcept
+{
+  max_bytes = std::min(max_bytes, size_);
+  size_ -= max_bytes;
+
+  std::size_t remaining = max_bytes;
+  while (remaining)
+  {
+    assert(offset_ < segments_.size());
+    byte_slice& segment = segments_[offset_];
+    remaining -= segment.remove_prefix(remaining);
+    if (segment.empty())
+      ++offset_;
+  }
+
+  if (offset_ == segments_.size())
+  {
+    segments_.clear();
+    offset_ = 0;
+  }
+  return max_bytes;
+}
+
+expect<void> byte_chain::write(const int fd)
+{
+  while (!empty())
+  {
+    iovec vectors[64];
+    const std::size_t count = std::min({segment_count(), max_iov, sizeof(vectors) / sizeof(vectors[0])});
+
+    auto segment = begin();
+    for (std::size_t i = 0; i < count; ++i, ++segment)
+    {
+      vectors[i].iov_base = const_cast<std::uint8_t*>(segment->data());
+      vectors[i].iov_len = segment->size();
+    }
+
+    const ssize_t written = ::writev(fd, vectors, count);
+    if (written < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      return {std::error_code{errno, std::system_category()}};
+    }
+    remove_prefix(written);
+  }
+  return success();
+}
@@ -0,0 +1,102 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "byte_slice.hpp"
+#include "expect.hpp"
+#include "span.hpp"
+
+/*! \brief Ordered list of `byte_slice` segments, never copied into a single
+    buffer.
+
+    `byte_slice{std::initializer_list<span>}` always copies its sources into a
+    new allocation. This class instead keeps a reference to each segment, so
+    output assembled from several independent buffers (framing + payload, or
+    several secrets) can be handed to the kernel with a single `writev`. */
+class byte_chain
+{
+  std::vector<byte_slice> segments_;
+  std::size_t size_; //!< Total bytes across `segments_`
+  std::size_t offset_; //!< Index of first segment with remaining bytes
+
+public:
+  using const_iterator = std::vector<byte_slice>::const_iterator;
+
+  byte_chain() noexcept
+    : segments_(), size_(0), offset_(0)
+  {}
+
+  byte_chain(byte_chain&& rhs) noexcept;
+  ~byte_chain() noexcept = default;
+  byte_chain& operator=(byte_chain&& rhs) noexcept;
+
+  //! \return Iterator to first segment with remaining bytes.
+  const_iterator begin() const noexcept { return segments_.begin() + offset_; }
+  const_iterator end() const noexcept { return segments_.end(); }
+
+  bool empty() const noexcept { return size_ == 0; }
+
+  //! \return Total bytes across all segments.
+  std::size_t size() const noexcept { return size_; }
+
+  //! \return Number of segments with remaining bytes.
+  std::size_t segment_count() const noexcept { return segments_.size() - offset_; }
+
+  //! Release all segments. \post `empty()`.
+  void clear() noexcept;
+
+  /*! Append `segment` to end of chain without copying bytes. Empty segments
+      are dropped.
+      \throw std::bad_alloc If segment list cannot be expanded. */
+  void push_back(byte_slice segment);
+
+  /*! Append all segments of `source` to end of chain without copying bytes.
+      \post `source.empty()`
+      \throw std::bad_alloc If segment list cannot be expanded. */
+  void append(byte_chain&& source);
+
+  /*! Copy bytes from the beginning of `this` chain into `dest`. The chain is
+      not modified.
+      \return Number of bytes copied, `min(dest.size(), size())`. */
+  std::size_t copy_prefix(span<std::uint8_t> dest) const noexcept;
+
+  /*! Drop bytes from the beginning of `this` chain. Segments that become
+      empty are released immediately.
+      \return Number of bytes removed. */
+  std::size_t remove_prefix(std::size_t max_bytes) noexcept;
+
+  /*! Write entire chain to `fd` using `writev`. Partial writes and `EINTR`
+      are retried, so the chain is submitted in one call unless the kernel
+      pipe/socket buffer is full or the chain has more than 64 segments.
+      \post `empty()` on success. Written bytes are removed on error.
+      \return Success, or `std::errc` value from `writev`. */
+  expect<void> write(int fd);
+};
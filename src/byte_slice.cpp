@@ -203,6 +203,19 @@ namespace
       portion_ = nullptr;
   }
 
+  byte_slice::byte_slice(byte_buffer buffer, const std::size_t size) noexcept
+    : storage_(nullptr), portion_(buffer.get(), size)
+  {
+    if (buffer && size)
+    {
+      std::uint8_t* const data = buffer.release() - sizeof(raw_byte_slice);
+      new (data) raw_byte_slice{};
+      storage_.reset(reinterpret_cast<raw_byte_slice*>(data));
+    }
+    else
+      portion_ = nullptr;
+  }
+
   byte_slice::byte_slice(byte_slice&& source) noexcept
     : storage_(std::move(source.storage_)), portion_(source.portion_)
   {
@@ -55,6 +55,9 @@
     void operator()(std::uint8_t* buf) const noexcept;
   };
 
+  //! Alias for a buffer that has space for a `byte_slice` ref count.
+  using byte_buffer = std::unique_ptr<std::uint8_t, release_byte_buffer>;
+
   /*! Inspired by slices in golang. Storage is thread-safe reference counted,
       allowing for cheap copies or range selection on the bytes. The bytes
       owned by this class are always immutable.
@@ -114,6 +117,10 @@
     //! Convert `stream` into a slice with zero allocations.
     explicit byte_slice(byte_stream&& stream, bool shrink = true);
 
+    /*! Convert `buffer` with `size` initialized bytes into a slice with zero
+        allocations. `buffer` must be from `byte_buffer_resize`. */
+    explicit byte_slice(byte_buffer buffer, std::size_t size) noexcept;
+
     byte_slice(byte_slice&& source) noexcept;
     ~byte_slice() noexcept = default;
 
@@ -160,9 +167,6 @@
     std::unique_ptr<byte_slice_data, release_byte_slice> take_buffer() noexcept;
   };
 
-  //! Alias for a buffer that has space for a `byte_slice` ref count.
-  using byte_buffer = std::unique_ptr<std::uint8_t, release_byte_buffer>;
-
   /*! \return `buf` with a new size of exactly `length`. New bytes not
         initialized. A `nullptr` is returned on allocation failure. */
   byte_buffer byte_buffer_resize(byte_buffer buf, std::size_t length) noexcept;
@@ -0,0 +1,119 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "decoder.hpp"
+
+#include <cstring>
+#include <memory>
+
+#include "crypto/sha256.h"
+#include "error.hpp"
+#include "packed_wordlist.hpp"
+#include "word_hash.hpp"
+
+namespace bip39
+{
+  namespace
+  {
+    constexpr const std::size_t max_entropy = 32;
+    constexpr const std::size_t max_words = (max_entropy * 3) / 4;
+
+    bool is_space(const char c) noexcept
+    {
+      return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    //! \return `word_list` index of `word`, or `word_hash::empty`.
+    std::uint16_t find_word(const span<const char> word) noexcept
+    {
+      if (word.size() < 3 || max_word_size < word.size())
+        return word_hash::empty;
+
+      std::uint64_t packed = 0;
+      std::memcpy(std::addressof(packed), word.data(), word.size());
+
+      const std::uint16_t index = word_hash::find(std::uint32_t(packed));
+      if (index == word_hash::empty)
+        return index;
+
+      const packed_word& entry = packed_word_list[index];
+      if (entry.bytes != packed || entry.size != word.size())
+        return word_hash::empty;
+      return index;
+    }
+  } // anonymous
+
+  expect<byte_slice> decode(const span<const char> mnemonic)
+  {
+    // entropy + checksum byte, filled 11 bits at a time
+    std::uint8_t bits[max_entropy + 1] = {0};
+    std::size_t used = 0;
+    std::size_t words = 0;
+    std::uint32_t window = 0;
+    unsigned window_bits = 0;
+
+    const char* current = mnemonic.begin();
+    const char* const end = mnemonic.end();
+    while (true)
+    {
+      while (current != end && is_space(*current))
+        ++current;
+      if (current == end)
+        break;
+
+      const char* const start = current;
+      while (current != end && !is_space(*current))
+        ++current;
+
+      const std::uint16_t index = find_word({start, std::size_t(current - start)});
+      if (index == word_hash::empty || words == max_words)
+        return {common_error::invalid_mnemonic};
+      ++words;
+
+      window = (window << 11) | index;
+      window_bits += 11;
+      for ( ; 8 <= window_bits; window_bits -= 8)
+        bits[used++] = std::uint8_t(window >> (window_bits - 8));
+    }
+
+    if (words != 12 && words != 18 && words != 24)
+      return {common_error::invalid_mnemonic};
+    if (window_bits)
+      bits[used] = std::uint8_t(window << (8 - window_bits));
+
+    const std::size_t entropy = (words * 4) / 3;
+    const unsigned checksum_bits = entropy / 4;
+
+    unsigned char hash[crypto_hash_sha256_BYTES] = {0};
+    if (crypto_hash_sha256(hash, bits, entropy))
+      return {common_error::hash_failure};
+    if ((hash[0] >> (8 - checksum_bits)) != (bits[entropy] >> (8 - checksum_bits)))
+      return {common_error::invalid_checksum};
+
+    return byte_slice{{span<const std::uint8_t>{bits, entropy}}};
+  }
+}
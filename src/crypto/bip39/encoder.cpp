@@ -50,50 +50,120 @@
  */
 
 #include "encoder.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <new>
+
 #include "byte_slice.hpp"
-#include "byte_stream.hpp"
 #include "crypto/sha256.h"
 #include "error.hpp"
-#include "wordlist.hpp"
+#include "packed_wordlist.hpp"
 
 namespace bip39
 {
-  expect<byte_slice> encode(byte_slice in)
+  namespace
+  {
+    constexpr const std::size_t max_entropy = 32;
+    constexpr const std::size_t max_words = (max_entropy * 3) / 4;
+    constexpr const std::size_t batch_size = 8;
+    static_assert(max_encoded_size(max_entropy) == max_words * (max_word_size + 1) - 1, "max_encoded_size mismatch");
+
+    bool valid_size(const std::size_t size) noexcept
+    {
+      return 16 <= size && size <= max_entropy && size % 8 == 0;
+    }
+
+    //! \return 11-bit index `i` from big-endian bit string `bits`.
+    unsigned get_index(const std::uint8_t* bits, const std::size_t i) noexcept
+    {
+      const std::size_t bit = i * 11;
+      std::uint64_t window = 0;
+      std::memcpy(std::addressof(window), bits + bit / 8, sizeof(window));
+      window = __builtin_bswap64(window); // configure requires little endian
+      return unsigned(window >> (64 - 11 - bit % 8)) & 0x7ff;
+    }
+
+    byte_slice encode_words(const span<const std::uint8_t> entropy, const std::uint8_t checksum)
+    {
+      // zero padded so the 64-bit window of the last index stays in bounds
+      std::uint8_t bits[max_entropy + sizeof(std::uint64_t)] = {0};
+      std::memcpy(bits, entropy.data(), entropy.size());
+      bits[entropy.size()] = checksum;
+
+      const std::size_t word_count = (entropy.size() * 3) / 4;
+      packed_word words[max_words];
+      std::size_t total = word_count - 1; // spaces
+      for (std::size_t i = 0; i < word_count; ++i)
+      {
+        words[i] = packed_word_list[get_index(bits, i)];
+        total += words[i].size;
+      }
+
+      byte_buffer buffer = byte_buffer_resize(nullptr, total);
+      if (!buffer)
+        throw std::bad_alloc{};
+
+      std::uint8_t* out = buffer.get();
+      std::uint8_t* const end = out + total;
+      for (std::size_t i = 0; i < word_count; ++i)
+      {
+        // full slot store when in bounds; next space/word overwrites padding
+        const std::size_t stored =
+          max_word_size <= std::size_t(end - out) ? max_word_size : words[i].size;
+        std::memcpy(out, std::addressof(words[i].bytes), stored);
+        out += words[i].size;
+        if (out != end)
+          *out++ = ' ';
+      }
+
+      return byte_slice{std::move(buffer), total};
+    }
+  } // anonymous
+
+  expect<byte_slice> encode(const byte_slice in)
   {
-    if (in.size() < 16 || 32 < in.size() || in.size() % 8 != 0)
+    if (!valid_size(in.size()))
       return {common_error::hash_failure};
 
     static_assert(1 <= crypto_hash_sha256_BYTES, "unexpected hash size");
+    unsigned char hash[crypto_hash_sha256_BYTES] = {0};
+    if (crypto_hash_sha256(hash, in.data(), in.size()))
+      return {common_error::hash_failure};
+
+    return encode_words(to_span(in), hash[0]);
+  }
+
+  expect<void> encode(const span<const byte_slice> in, span<byte_slice> out)
+  {
+    MACER_PRECOND(in.size() == out.size());
+    for (const byte_slice& secret : in)
     {
-      unsigned char hash[crypto_hash_sha256_BYTES] = {0};
-      if (crypto_hash_sha256(hash, in.data(), in.size()))
+      if (!valid_size(secret.size()))
         return {common_error::hash_failure};
-
-      byte_stream temp;
-      temp.write(to_span(in));
-      temp.put(hash[0]);
-      in = byte_slice{std::move(temp)};
     }
 
-    byte_stream words;
-    const unsigned word_count = ((in.size() - 1) * 3) / 4;
-    for (unsigned i = 0; i < word_count; ++i)
+    unsigned char hash[batch_size][crypto_hash_sha256_BYTES] = {{0}};
+    const unsigned char* sources[batch_size] = {nullptr};
+    unsigned long long sizes[batch_size] = {0};
+
+    for (std::size_t base = 0; base < in.size(); base += batch_size)
     {
-      // bit at a time, based on Trezor source
-      unsigned index = 0; 
-      for (unsigned j = 0; j < 11; j++) {
-        index <<= 1;
-        index += (in.data()[(i * 11 + j) / 8] & (1 << (7 - ((i * 11 + j) % 8)))) > 0;
+      const std::size_t count = std::min(batch_size, in.size() - base);
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        sources[i] = in[base + i].data();
+        sizes[i] = in[base + i].size();
       }
 
-      char const * const word = word_list[index];
-      words.write(word, strlen(word));
+      if (crypto_hash_sha256_many(hash, sources, sizes, count))
+        return {common_error::hash_failure};
 
-      if (i != word_count - 1)
-      	words.put(' ');
+      for (std::size_t i = 0; i < count; ++i)
+        out[base + i] = encode_words(to_span(in[base + i]), hash[i][0]);
     }
 
-    return byte_slice{std::move(words)};
+    return success();
   }
 }
-
@@ -27,10 +27,26 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include "byte_slice.hpp"
 #include "expect.hpp"
+#include "span.hpp"
 
 namespace bip39
 {
+  //! \return Longest mnemonic `encode` can return for `size` bytes of entropy.
+  constexpr std::size_t max_encoded_size(const std::size_t size) noexcept
+  {
+    return (size * 3 / 4) * 9 - 1; // 8 byte words, separated by one space
+  }
+
+  //! \return Mnemonic for 16, 24, or 32 bytes of entropy in `in`.
   expect<byte_slice> encode(byte_slice in);
+
+  /*! Batch `encode`; checksums are computed in parallel SIMD lanes when
+      available. `out[i]` is the mnemonic for `in[i]`.
+
+      \pre `in.size() == out.size()` */
+  expect<void> encode(span<const byte_slice> in, span<byte_slice> out);
 }
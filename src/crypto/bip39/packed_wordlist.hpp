@@ -0,0 +1,131 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "wordlist.hpp"
+
+namespace bip39
+{
+  //! Longest word in `word_list`; every word fits into one 64-bit load/store.
+  constexpr const std::size_t max_word_size = 8;
+
+  /*! A wordlist entry: the word text packed into the 8-byte `bytes` field
+      (one 64-bit load/store), with its length stored next to it. */
+  struct packed_word
+  {
+    std::uint64_t bytes; //!< Little-endian; unused trailing bytes are zero
+    std::uint8_t size;
+  };
+
+  namespace detail
+  {
+    constexpr std::size_t word_size(const char* word, const std::size_t i = 0)
+    {
+      return word[i] == 0 ? i : word_size(word, i + 1);
+    }
+
+    constexpr std::uint64_t pack_word(const char* word, const std::size_t i = 0)
+    {
+      return (i == max_word_size || word[i] == 0) ?
+        0 : (std::uint64_t(std::uint8_t(word[i])) << (i * 8)) | pack_word(word, i + 1);
+    }
+
+    constexpr bool check_word(const char* word)
+    {
+      return word_size(word) <= max_word_size;
+    }
+
+    template<std::size_t... I>
+    struct indices
+    {};
+
+    template<typename L, typename R>
+    struct concat_indices;
+
+    template<std::size_t... L, std::size_t... R>
+    struct concat_indices<indices<L...>, indices<R...>>
+    {
+      using type = indices<L..., (sizeof...(L) + R)...>;
+    };
+
+    //! C++11 `make_index_sequence` with log(N) template depth.
+    template<std::size_t N>
+    struct make_indices
+      : concat_indices<typename make_indices<N / 2>::type, typename make_indices<N - N / 2>::type>
+    {};
+
+    template<>
+    struct make_indices<0>
+    {
+      using type = indices<>;
+    };
+
+    template<>
+    struct make_indices<1>
+    {
+      using type = indices<0>;
+    };
+
+    //! Binary recursion keeps constexpr depth at log(N) in C++11.
+    constexpr bool check_words(const std::size_t begin, const std::size_t end)
+    {
+      return end - begin == 1 ?
+        check_word(word_list[begin]) :
+        check_words(begin, begin + (end - begin) / 2) && check_words(begin + (end - begin) / 2, end);
+    }
+
+    template<std::size_t... I>
+    struct packed_words
+    {
+      static constexpr const packed_word value[sizeof...(I)] = {
+        {pack_word(word_list[I]), std::uint8_t(word_size(word_list[I]))}...
+      };
+    };
+
+    template<std::size_t... I>
+    constexpr const packed_word packed_words<I...>::value[sizeof...(I)];
+
+    template<typename T>
+    struct make_packed;
+
+    template<std::size_t... I>
+    struct make_packed<indices<I...>>
+      : packed_words<I...>
+    {};
+  } // detail
+
+  static_assert(detail::check_words(0, 2048), "word exceeds packed slot");
+
+  /*! Compile-time copy of `word_list` with precomputed sizes, so encoding
+      needs neither `strlen` nor a pointer chase per word. */
+  static constexpr const packed_word (&packed_word_list)[2048] =
+    detail::make_packed<detail::make_indices<2048>::type>::value;
+} // bip39
@@ -0,0 +1,472 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "packed_wordlist.hpp"
+
+namespace bip39
+{
+  /*! Compile-time perfect hash from a BIP-39 word to its `word_list` index.
+      Every English word is unique in its first 4 letters, so the key is the
+      4 letter prefix packed into 32 bits. Two-level "hash and displace": the
+      key selects one of 512 buckets, whose displacement is mixed with the key
+      to select one of 4096 slots. The tables were searched offline; the
+      `static_assert` below proves they are collision-free for `word_list`.
+
+      A slot hit is only a candidate - callers must compare the full word
+      against `packed_word_list` to reject words not in the list. */
+  namespace word_hash
+  {
+    constexpr const std::size_t bucket_bits = 9;
+    constexpr const std::size_t slot_bits = 12;
+    constexpr const std::uint16_t empty = 0xffff;
+
+    //! \return Up to first 4 bytes of `word` in little-endian order.
+    constexpr std::uint32_t key(const char* word, const std::size_t i = 0)
+    {
+      return (i == 4 || word[i] == 0) ?
+        0 : (std::uint32_t(std::uint8_t(word[i])) << (i * 8)) | key(word, i + 1);
+    }
+
+    constexpr std::uint32_t bucket(const std::uint32_t key) noexcept
+    {
+      return std::uint32_t(key * 0x9e3779b1u) >> (32 - bucket_bits);
+    }
+
+    // 32-bit finalizer (lowbias32), split for C++11 constexpr
+    constexpr std::uint32_t mix2(const std::uint32_t x) noexcept { return x ^ (x >> 16); }
+    constexpr std::uint32_t mix1(const std::uint32_t x) noexcept { return mix2(std::uint32_t((x ^ (x >> 15)) * 0x846ca68bu)); }
+    constexpr std::uint32_t mix(const std::uint32_t x) noexcept { return mix1(std::uint32_t((x ^ (x >> 16)) * 0x7feb352du)); }
+
+    //! Per-bucket displacement, indexed by `bucket(key)`.
+    constexpr const std::uint8_t displacement[std::size_t(1) << bucket_bits] = {
+      0x04, 0x03, 0x00, 0x04, 0x01, 0x01, 0x02, 0x05, 0x01, 0x02, 0x00, 0x00, 0x0a, 0x02, 0x05, 0x00,
+      0x10, 0x01, 0x06, 0x01, 0x00, 0x03, 0x10, 0x03, 0x00, 0x01, 0x00, 0x00, 0x01, 0x02, 0x08, 0x00,
+      0x01, 0x0d, 0x03, 0x02, 0x14, 0x00, 0x00, 0x05, 0x01, 0x06, 0x03, 0x01, 0x02, 0x00, 0x00, 0x01,
+      0x1a, 0x06, 0x0e, 0x00, 0x09, 0x06, 0x03, 0x04, 0x00, 0x04, 0x02, 0x04, 0x00, 0x08, 0x00, 0x00,
+      0x0e, 0x04, 0x00, 0x02, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x03, 0x01, 0x00, 0x00, 0x06,
+      0x0c, 0x00, 0x07, 0x03, 0x01, 0x01, 0x00, 0x00, 0x12, 0x03, 0x04, 0x08, 0x01, 0x00, 0x00, 0x04,
+      0x00, 0x00, 0x05, 0x02, 0x00, 0x00, 0x05, 0x0a, 0x00, 0x01, 0x05, 0x08, 0x00, 0x00, 0x00, 0x08,
+      0x03, 0x01, 0x00, 0x00, 0x09, 0x04, 0x06, 0x02, 0x02, 0x04, 0x01, 0x00, 0x07, 0x02, 0x13, 0x00,
+      0x00, 0x01, 0x06, 0x00, 0x07, 0x00, 0x02, 0x00, 0x05, 0x00, 0x00, 0x00, 0x08, 0x03, 0x12, 0x00,
+      0x00, 0x01, 0x00, 0x06, 0x03, 0x00, 0x00, 0x00, 0x0a, 0x05, 0x05, 0x04, 0x00, 0x01, 0x00, 0x00,
+      0x00, 0x05, 0x02, 0x00, 0x05, 0x09, 0x00, 0x01, 0x02, 0x04, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01,
+      0x0a, 0x01, 0x06, 0x00, 0x00, 0x02, 0x00, 0x01, 0x03, 0x02, 0x02, 0x00, 0x00, 0x1e, 0x09, 0x00,
+      0x00, 0x00, 0x01, 0x02, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00, 0x03, 0x08, 0x02, 0x05, 0x09, 0x00,
+      0x01, 0x00, 0x06, 0x02, 0x01, 0x03, 0x05, 0x00, 0x00, 0x0a, 0x0a, 0x01, 0x0b, 0x04, 0x04, 0x02,
+      0x00, 0x01, 0x06, 0x0c, 0x00, 0x03, 0x0e, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x02, 0x05,
+      0x05, 0x02, 0x06, 0x0d, 0x00, 0x0c, 0x11, 0x06, 0x00, 0x0b, 0x02, 0x04, 0x08, 0x02, 0x10, 0x01,
+      0x01, 0x00, 0x02, 0x03, 0x00, 0x05, 0x08, 0x01, 0x01, 0x03, 0x00, 0x01, 0x01, 0x00, 0x0f, 0x03,
+      0x04, 0x02, 0x06, 0x01, 0x01, 0x03, 0x01, 0x00, 0x07, 0x00, 0x00, 0x18, 0x02, 0x04, 0x03, 0x03,
+      0x00, 0x00, 0x02, 0x02, 0x00, 0x04, 0x00, 0x00, 0x04, 0x09, 0x00, 0x02, 0x00, 0x01, 0x01, 0x00,
+      0x00, 0x00, 0x02, 0x03, 0x02, 0x00, 0x00, 0x03, 0x02, 0x00, 0x04, 0x00, 0x00, 0x01, 0x04, 0x03,
+      0x01, 0x0a, 0x09, 0x02, 0x00, 0x06, 0x04, 0x01, 0x01, 0x04, 0x01, 0x03, 0x01, 0x03, 0x06, 0x06,
+      0x02, 0x01, 0x03, 0x06, 0x02, 0x07, 0x04, 0x00, 0x01, 0x06, 0x0b, 0x00, 0x01, 0x03, 0x02, 0x08,
+      0x06, 0x04, 0x00, 0x01, 0x03, 0x07, 0x02, 0x00, 0x02, 0x0d, 0x00, 0x08, 0x00, 0x00, 0x03, 0x02,
+      0x03, 0x03, 0x03, 0x19, 0x0c, 0x00, 0x00, 0x01, 0x00, 0x09, 0x0f, 0x02, 0x06, 0x0a, 0x00, 0x00,
+      0x06, 0x00, 0x02, 0x00, 0x01, 0x05, 0x03, 0x01, 0x02, 0x02, 0x00, 0x04, 0x02, 0x00, 0x08, 0x01,
+      0x0c, 0x02, 0x05, 0x01, 0x01, 0x06, 0x00, 0x00, 0x00, 0x06, 0x00, 0x01, 0x01, 0x00, 0x05, 0x06,
+      0x0e, 0x00, 0x02, 0x06, 0x00, 0x03, 0x08, 0x00, 0x00, 0x02, 0x00, 0x00, 0x09, 0x08, 0x00, 0x0c,
+      0x00, 0x01, 0x00, 0x00, 0x03, 0x05, 0x02, 0x00, 0x07, 0x02, 0x06, 0x03, 0x0d, 0x02, 0x00, 0x04,
+      0x01, 0x00, 0x00, 0x00, 0x0f, 0x00, 0x05, 0x07, 0x08, 0x01, 0x00, 0x02, 0x02, 0x01, 0x01, 0x04,
+      0x08, 0x01, 0x00, 0x01, 0x3e, 0x00, 0x00, 0x01, 0x07, 0x00, 0x09, 0x02, 0x06, 0x03, 0x00, 0x00,
+      0x01, 0x01, 0x00, 0x00, 0x01, 0x01, 0x0e, 0x06, 0x00, 0x06, 0x06, 0x05, 0x03, 0x01, 0x03, 0x00,
+      0x01, 0x02, 0x00, 0x06, 0x03, 0x0d, 0x03, 0x05, 0x01, 0x05, 0x00, 0x03, 0x02, 0x06, 0x00, 0x02
+    };
+
+    //! `word_list` index (or `empty`), indexed by `slot(key)`.
+    constexpr const std::uint16_t slots[std::size_t(1) << slot_bits] = {
+      0xffff, 0x068c, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x062c, 0x0701, 0x074f, 0x06f6, 0xffff,
+      0x0499, 0xffff, 0x061d, 0x029e, 0x0042, 0x01bd, 0xffff, 0x03ee, 0x0614, 0xffff, 0xffff, 0xffff,
+      0x0398, 0xffff, 0xffff, 0xffff, 0x0626, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x02ff, 0x00a4,
+      0x0611, 0x03cf, 0x07d1, 0xffff, 0x041f, 0xffff, 0xffff, 0xffff, 0x0376, 0x0156, 0x07e7, 0x02e5,
+      0x0441, 0xffff, 0x0557, 0xffff, 0x025f, 0x07c7, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff,
+      0x0699, 0xffff, 0xffff, 0xffff, 0x0305, 0xffff, 0x05df, 0xffff, 0x070e, 0xffff, 0x075e, 0xffff,
+      0xffff, 0x00a5, 0x0460, 0x07d9, 0x0224, 0xffff, 0xffff, 0x0799, 0x0356, 0xffff, 0xffff, 0x03ac,
+      0x0478, 0x00da, 0xffff, 0x07d5, 0x04c5, 0x0164, 0xffff, 0x0507, 0x01e7, 0xffff, 0xffff, 0xffff,
+      0x0442, 0x06c3, 0xffff, 0x0521, 0xffff, 0xffff, 0x041e, 0x046e, 0xffff, 0xffff, 0xffff, 0xffff,
+      0xffff, 0x03f2, 0xffff, 0x065c, 0xffff, 0x0363, 0xffff, 0xffff, 0x01d0, 0xffff, 0x0789, 0xffff,
+      0xffff, 0x02eb, 0xffff, 0x0220, 0xffff, 0x0387, 0x062d, 0x013d, 0xffff, 0x06e6, 0x02d6, 0x0523,
+      0x0317, 0x05ba, 0x005f, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x0582, 0x00b8, 0xffff, 0xffff,
+      0x0673, 0x00b9, 0x0756, 0xffff, 0x0111, 0x05ee, 0x078b, 0xffff, 0x070b, 0x0197, 0xffff, 0xffff,
+      0x02ab, 0x0196, 0xffff, 0x01c8, 0xffff, 0x016c, 0x0005, 0x05f3, 0xffff, 0xffff, 0xffff, 0xffff,
+      0xffff, 0xffff, 0x015b, 0x04fd, 0xffff, 0x00d7, 0xffff, 0xffff, 0xffff, 0x03f9, 0xffff, 0xffff,
+      0xffff, 0x052f, 0xffff, 0xffff, 0x0203, 0x0415, 0xffff, 0x0055, 0x00d0, 0x0700, 0xffff, 0x0405,
+      0x0276, 0xffff, 0xffff, 0xffff, 0x0223, 0xffff, 0xffff, 0x0018, 0xffff, 0x02bc, 0x00e7, 0xffff,
+      0xffff, 0xffff, 0xffff, 0x007f, 0xffff, 0x0231, 0xffff, 0x063c, 0xffff, 0xffff, 0xffff, 0x055b,
+      0xffff, 0x04c9, 0x0783, 0xffff, 0x01f1, 0xffff, 0x00f3, 0xffff, 0xffff, 0x056b, 0x0709, 0x0014,
+      0x041d, 0xffff, 0x0457, 0x01bb, 0xffff, 0xffff, 0xffff, 0x0391, 0xffff, 0x01f8, 0x06c6, 0xffff,
+      0xffff, 0x01db, 0xffff, 0xffff, 0xffff, 0x06a6, 0xffff, 0xffff, 0xffff, 0xffff, 0x02d5, 0xffff,
+      0xffff, 0x0388, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x047e, 0x07f3, 0x0323, 0x0504,
+      0xffff, 0x043e, 0xffff, 0xffff, 0xffff, 0xffff, 0x014d, 0xffff, 0x06ee, 0xffff, 0x07d6, 0x065e,
+      0xffff, 0xffff, 0xffff, 0x0636, 0x03be, 0x015e, 0x0579, 0x07ea, 0x0570, 0xffff, 0x021d, 0x051a,
+      0xffff, 0x04b7, 0x0657, 0x0091, 0x042f, 0x0039, 0xffff, 0xffff, 0xffff, 0x03cb, 0xffff, 0x0255,
+      0xffff, 0xffff, 0xffff, 0x0623, 0x0315, 0xffff, 0xffff, 0x067d, 0xffff, 0x04dd, 0x051f, 0xffff,
+      0x0286, 0xffff, 0x00d4, 0x044a, 0x0423, 0xffff, 0x03a1, 0x0797, 0xffff, 0x04f3, 0x013f, 0x02ef,
+      0x06e7, 0x0459, 0xffff, 0xffff, 0xffff, 0xffff, 0x068d, 0xffff, 0x0461, 0xffff, 0x0060, 0xffff,
+      0x01e2, 0xffff, 0xffff, 0xffff, 0xffff, 0x0717, 0xffff, 0xffff, 0x0722, 0x05de, 0xffff, 0x0658,
+      0xffff, 0x01c6, 0x0357, 0xffff, 0xffff, 0x0207, 0xffff, 0x067f, 0xffff, 0x01b1, 0xffff, 0x078d,
+      0xffff, 0x0578, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x0761, 0xffff, 0x0645, 0x017c, 0xffff,
+      0xffff, 0x057b, 0x0116, 0x0118, 0x050b, 0x034c, 0xffff, 0xffff, 0xffff, 0x05fc, 0x00df, 0x0663,
+      0x0566, 0x0097, 0x01ca, 0x04e9, 0xffff, 0xffff, 0xffff, 0xffff, 0x06a3, 0x017d, 0xffff, 0x04a8,
+      0xffff, 0xffff, 0xffff, 0xffff, 0x07ef, 0x02f2, 0xffff, 0x04b5, 0xffff, 0x0621, 0xffff, 0x05a8,
+      0xffff, 0x012d, 0x0180, 0x066a, 0xffff, 0x01a3, 0x0208, 0x024b, 0xffff, 0x0522, 0x05fd, 0x033c,
+      0x0013, 0x021b, 0x0451, 0x0373, 0xffff, 0xffff, 0x041c, 0x0303, 0xffff, 0xffff, 0xffff, 0xffff,
+      0xffff, 0xffff, 0x0114, 0xffff, 0x03fc, 0x00f2, 0xffff, 0x07f9, 0xffff, 0xffff, 0xffff, 0x03ef,
+      0x07fb, 0xffff, 0x030e, 0xffff, 0x04fa, 0x06a7, 0xffff, 0xffff, 0xffff, 0x053c, 0x018d, 0xffff,
+      0xffff, 0xffff, 0xffff, 0x02a3, 0xffff, 0x031a, 0x07fc, 0xffff, 0x05f0, 0xffff, 0xffff, 0x058e,
+      0x07d7, 0xffff, 0x0446, 0xffff, 0x043d, 0x03ea, 0xffff, 0xffff, 0x0162, 0x027e, 0xffff, 0xffff,
+      0x0632, 0x028b, 0x0205, 0x01ef, 0xffff, 0x0235, 0x0477, 0xffff, 0x01e4, 0x0608, 0x078a, 0x0381,
+      0xffff, 0xffff, 0xffff, 0x018f, 0x00f4, 0xffff, 0xffff, 0x0686, 0xffff, 0xffff, 0x0556, 0xffff,
+      0xffff, 0xffff, 0xffff, 0x03bc, 0x03bf, 0xffff, 0x0406, 0x00b0, 0x0256, 0xffff, 0xffff, 0xffff,
+      0xffff, 0xffff, 0x04a1, 0x0454, 0x05e6, 0x06f9, 0x0392, 0xffff, 0x05d3, 0xffff, 0x06db, 0xffff,
+      0x0687, 0x079f, 0xffff, 0xffff, 0xffff, 0x0741, 0x04aa, 0x0087, 0xffff, 0x0035, 0x023c, 0xffff,
+      0x052a, 0xffff, 0x030f, 0x046a, 0xffff, 0xffff, 0x0263, 0xffff, 0xffff, 0xffff, 0x0001, 0x05ff,
+      0xffff, 0xffff, 0xffff, 0xffff, 0x040e, 0xffff, 0xffff, 0x037e, 0xffff, 0xffff, 0x0472, 0xffff,
+      0xffff, 0x069d, 0x01a4, 0xffff, 0xffff, 0xffff, 0xffff, 0x001d, 0x00fb, 0xffff, 0x009e, 0xffff,
+      0xffff, 0xffff, 0xffff, 0x0218, 0x04b8, 0x0641, 0xffff, 0x01d7, 0xffff, 0x0371, 0x009d, 0xffff,
+      0xffff, 0x02c7, 0x07a3, 0xffff, 0x00e3, 0x06e3, 0x0123, 0x0053, 0xffff, 0x0025, 0xffff, 0x064d,
+      0x0260, 0x0678, 0x03b4, 0xffff, 0x0612, 0x0159, 0x0650, 0xffff, 0xffff, 0x027a, 0x04fb, 0x0470,
+      0x0226, 0xffff, 0x0383, 0x02a4, 0xffff, 0x04b0, 0x0792, 0x03c5, 0xffff, 0xffff, 0x0090, 0x0077,
+      0x06d8, 0xffff, 0xffff, 0xffff, 0x032f, 0xffff, 0x04f4, 0xffff, 0xffff, 0x03d9, 0xffff, 0x019d,
+      0xffff, 0x0291, 0x00f1, 0xffff, 0x05c4, 0xffff, 0xffff, 0xffff, 0x034a, 0x062f, 0xffff, 0xffff,
+      0xffff, 0x02cf, 0xffff, 0xffff, 0xffff, 0x0750, 0x03ce, 0xffff, 0xffff, 0xffff, 0x03a0, 0xffff,
+      0xffff, 0xffff, 0x0505, 0xffff, 0x044f, 0x07f1, 0x07f6, 0x06d4, 0xffff, 0x00dd, 0x00e8, 0x02af,
+      0x0190, 0xffff, 0xffff, 0x07b5, 0xffff, 0xffff, 0x02ae, 0xffff, 0xffff, 0x0615, 0xffff, 0xffff,
+      0x05dc, 0x0008, 0xffff, 0x05f8, 0xffff, 0xffff, 0xffff, 0x0704, 0xffff, 0x0580, 0x0453, 0xffff,
+      0x02e0, 0xffff, 0x0606, 0xffff, 0x0243, 0xffff, 0x0265, 0x05a3, 0xffff, 0xffff, 0x05e3, 0x07e0,
+      0xffff, 0xffff, 0x0560, 0x0088, 0xffff, 0x0064, 0xffff, 0x026f, 0xffff, 0xffff, 0x05a7, 0x0318,
+      0x019c, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x00bd, 0x04da, 0x0148,
+      0xffff, 0xffff, 0xffff, 0x02c3, 0xffff, 0x0322, 0xffff, 0xffff, 0xffff, 0x0247, 0x0166, 0xffff,
+      0x0576, 0x0201, 0x00f9, 0x04ec, 0xffff, 0x006e, 0x0616, 0x0634, 0xffff, 0xffff, 0xffff, 0xffff,
+      0xffff, 0x0479, 0x076b, 0x0360, 0x03ca, 0x011a, 0x04bb, 0xffff, 0xffff, 0x006f, 0x0497, 0xffff,
+      0xffff, 0xffff, 0x0375, 0xffff, 0xffff, 0x07f4, 0xffff, 0xffff, 0xffff, 0xffff, 0x018a, 0xffff,
+      0x059a, 0xffff, 0xffff, 0xffff, 0x0320, 0x0027, 0x00f8, 0x0075, 0x035e, 0x024c, 0x006d, 0xffff,
+      0xffff, 0xffff, 0xffff, 0x01b4, 0xffff, 0x05cb, 0x01cf, 0x02b8, 0x0473, 0xffff, 0x03a2, 0xffff,
+      0x0475, 0xffff, 0xffff, 0x01fe, 0xffff, 0x00fd, 0xffff, 0x0294, 0xffff, 0xffff, 0xffff, 0x0038,
+      0x0073, 0x004e, 0x072b, 0x00db, 0x0282, 0xffff, 0xffff, 0x0173, 0x0759, 0xffff, 0xffff, 0x0233,
+      0x07af, 0xffff, 0x028e, 0x025c, 0xffff, 0x067a, 0xffff, 0xffff, 0x0513, 0xffff, 0xffff, 0x00a3,
+      0xffff, 0xffff, 0x0185, 0x0158, 0x0685, 0x05c8, 0xffff, 0xffff, 0x0620, 0x0534, 0xffff, 0xffff,
+      0xffff, 0x074d, 0x067b, 0xffff, 0xffff, 0xffff, 0xffff, 0x06cf, 0xffff, 0x05f4, 0xffff, 0xffff,
+      0x0742, 0x0034, 0x0002, 0xffff, 0x03e5, 0x0748, 0x068e, 0xffff, 0xffff, 0x0269, 0xffff, 0xffff,
+      0xffff, 0x0157, 0xffff, 0xffff, 0xffff, 0xffff, 0x04ee, 0xffff, 0x0403, 0xffff, 0xffff, 0xffff,
+      0x01d8, 0x02d4, 0xffff, 0xffff, 0xffff, 0xffff, 0x0547, 0xffff, 0x0078, 0x0670, 0x054c, 0xffff,
+      0x000d, 0xffff, 0xffff, 0xffff, 0x0496, 0x04f0, 0x0651, 0x008d, 0x0567, 0xffff, 0xffff, 0xffff,
+      0x0635, 0xffff, 0xffff, 0xffff, 0xffff, 0x079d, 0xffff, 0xffff, 0xffff, 0x058d, 0xffff, 0xffff,
+      0xffff, 0xffff, 0xffff, 0x06a1, 0x026c, 0xffff, 0xffff, 0xffff, 0x00a8, 0x05e8, 0xffff, 0x071c,
+      0xffff, 0xffff, 0xffff, 0xffff, 0x0561, 0xffff, 0x0295, 0xffff, 0xffff, 0x0519, 0x0066, 0xffff,
+      0x0176, 0x00b2, 0xffff, 0x03c8, 0x06f3, 0xffff, 0xffff, 0x06ae, 0x0273, 0xffff, 0x0490, 0x00e9,
+      0xffff, 0x025a, 0xffff, 0x0366, 0xffff, 0xffff, 0x0537, 0xffff, 0x02c9, 0xffff, 0x06ea, 0x0535,
+      0xffff, 0x04c6, 0x04ce, 0xffff, 0x023e, 0x01a5, 0xffff, 0x05ab, 0xffff, 0xffff, 0x06a4, 0x0720,
+      0x01ae, 0x02a1, 0xffff, 0x03d0, 0xffff, 0x0551, 0x05a9, 0x014e, 0xffff, 0x07bd, 0x00c1, 0x07b6,
+      0x04be, 0x02dc, 0x0085, 0xffff, 0x071e, 0xffff, 0x056d, 0xffff, 0x0335, 0xffff, 0x073f, 0xffff,
+      0x0729, 0xffff, 0x04f8, 0x036f, 0xffff, 0xffff, 0xffff, 0x028a, 0x0583, 0xffff, 0xffff, 0x074b,
+      0xffff, 0xffff, 0xffff, 0x03a3, 0xffff, 0x026b, 0xffff, 0x0735, 0xffff, 0xffff, 0x07ab, 0xffff,
+      0x0414, 0xffff, 0x008f, 0x0408, 0xffff, 0x014f, 0xffff, 0x023d, 0xffff, 0x073a, 0x05ae, 0x00ef,
+      0xffff, 0x032b, 0xffff, 0xffff, 0x0279, 0x0425, 0x0695, 0xffff, 0xffff, 0x063d, 0x0129, 0x040b,
+      0xffff, 0xffff, 0x07da, 0xffff, 0xffff, 0x0149, 0xffff, 0x030d, 0xffff, 0xffff, 0xffff, 0xffff,
+      0xffff, 0xffff, 0x009c, 0xffff, 0x01b2, 0x0301, 0xffff, 0x01c5, 0x0024, 0xffff, 0xffff, 0x032a,
+      0x00ea, 0x002e, 0xffff, 0x00b7, 0x05f7, 0xffff, 0x05d4, 0x0222, 0x017f, 0xffff, 0xffff, 0xffff,
+      0xffff, 0xffff, 0xffff, 0x0483, 0x078f, 0x06d7, 0xffff, 0x047c, 0xffff, 0x03d6, 0x040a, 0xffff,
+      0xffff, 0xffff, 0xffff, 0xffff, 0x00e6, 0xffff, 0xffff, 0xffff, 0x05d0, 0xffff, 0x01a6, 0x02f7,
+      0xffff, 0x038e, 0x0435, 0xffff, 0x0031, 0xffff, 0x018b, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff,
+      0x01a2, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x0183, 0x04dc, 0x05c6, 0xffff, 0xffff, 0x0193,
+      0x0267, 0xffff, 0x005c, 0x0624, 0x01f0, 0xffff, 0x0107, 0xffff, 0x0675, 0x004f, 0x02c2, 0xffff,
+      0xffff, 0x0084, 0xffff, 0xffff, 0x0662, 0x03d7, 0x00eb, 0xffff, 0xffff, 0xffff, 0xffff, 0x04d4,
+      0x0125, 0x04fe, 0x0184, 0x0368, 0x05f2, 0x04ea, 0x0117, 0x0601, 0x06e1, 0x061f, 0xffff, 0xffff,
+      0xffff, 0x0254, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x0769, 0xffff, 0x06ad, 0x03fa,
+      0x0708, 0xffff, 0x05cf, 0xffff, 0xffff, 0x044e, 0xffff, 0x043b, 0xffff, 0xffff, 0x0684, 0xffff,
+      0xffff, 0x0288, 0xffff, 0xffff, 0xffff, 0x03fe, 0x03f5, 0xffff, 0x0104, 0x03db, 0xffff, 0xffff,
+      0xffff, 0xffff, 0x026a, 0xffff, 0xffff, 0x059e, 0x060c, 0x00ad, 0xffff, 0x054f, 0x04ed, 0x0754,
+      0x04e6, 0xffff, 0xffff, 0x034f, 0x0518, 0xffff, 0xffff, 0x0249, 0x0714, 0x0187, 0xffff, 0xffff,
+      0x0382, 0x0680, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x06e5, 0xffff, 0x06e9,
+      0xffff, 0x03e7, 0xffff, 0x007a, 0xffff, 0x0169, 0xffff, 0x0079, 0x0051, 0xffff, 0xffff, 0x0133,
+      0xffff, 0x01aa, 0xffff, 0x05f5, 0x02dd, 0x0043, 0xffff, 0xffff, 0xffff, 0x068b, 0x07c3, 0xffff,
+      0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x04ca, 0x023b, 0xffff, 0xffff, 0x0006, 0x07f7, 0x0642,
+      0x0509, 0x04c4, 0xffff, 0x0365, 0xffff, 0xffff, 0xffff, 0x0469, 0x0633, 0x019f, 0xffff, 0x07d3,
+      0xffff, 0xffff, 0x07df, 0xffff, 0x0773, 0x00b1, 0x05ef, 0xffff, 0x045c, 0x054d, 0xffff, 0x00cc,
+      0x0076, 0xffff, 0x03fd, 0xffff, 0xffff, 0xffff, 0x0165, 0xffff, 0xffff, 0xffff, 0x0434, 0xffff,
+      0x0174, 0x0520, 0x01ed, 0x004b, 0x0101, 0xffff, 0xffff, 0x046f, 0xffff, 0x0737, 0xffff, 0xffff,
+      0x00bb, 0xffff, 0x0689, 0x0177, 0xffff, 0x0389, 0xffff, 0xffff, 0x07f5, 0x0517, 0x0727, 0xffff,
+      0x05af, 0x0270, 0xffff, 0xffff, 0x06b7, 0xffff, 0xffff, 0xffff, 0x0555, 0x0562, 0xffff, 0xffff,
+      0x01e8, 0x018c, 0xffff, 0x050a, 0x005b, 0xffff, 0xffff, 0x06b2, 0xffff, 0xffff, 0x05b1, 0x0545,
+      0xffff, 0xffff, 0x02fc, 0xffff, 0xffff, 0x051b, 0x05a5, 0xffff, 0xffff, 0xffff, 0x0705, 0xffff,
+      0x048f, 0xffff, 0xffff, 0x04e2, 0x0056, 0xffff, 0x005a, 0xffff, 0xffff, 0x06d2, 0x0083, 0xffff,
+      0xffff, 0xffff, 0xffff, 0x0290, 0xffff, 0xffff, 0x0706, 0xffff, 0xffff, 0xffff, 0x058f, 0xffff,
+      0xffff, 0x042e, 0x04f9, 0x06bd, 0x061c, 0x03d2, 0xffff, 0xffff, 0x006a, 0xffff, 0xffff, 0x07ad,
+      0xffff, 0x01a1, 0xffff, 0x0639, 0x02b3, 0xffff, 0xffff, 0xffff, 0xffff, 0x0585, 0xffff, 0x03f1,
+      0x0637, 0x059c, 0xffff, 0x05b5, 0x0378, 0xffff, 0xffff, 0x077b, 0x023a, 0x02c4, 0xffff, 0xffff,
+      0xffff, 0x0544, 0xffff, 0x01be, 0xffff, 0xffff, 0x007e, 0x012b, 0x0000, 0x0766, 0xffff, 0x067e,
+      0x064a, 0x04a3, 0x04d1, 0x055c, 0x02ba, 0x02fd, 0x07cc, 0x0015, 0xffff, 0xffff, 0x06bf, 0x036a,
+      0x0328, 0x040d, 0xffff, 0x0694, 0xffff, 0x0302, 0xffff, 0xffff, 0xffff, 0x00a6, 0xffff, 0x05c9,
+      0x0124, 0xffff, 0xffff, 0xffff, 0xffff, 0x06a5, 0x0429, 0x001c, 0x07ce, 0xffff, 0x039a, 0xffff,
+      0xffff, 0xffff, 0xffff, 0x02b4, 0xffff, 0x0330, 0xffff, 0x0189, 0x02cb, 0x05ce, 0x0041, 0xffff,
+      0x0546, 0x021c, 0xffff, 0xffff, 0xffff, 0xffff, 0x0745, 0x020f, 0xffff, 0xffff, 0x0319, 0x0312,
+      0xffff, 0x033b, 0xffff, 0xffff, 0x028d, 0x0399, 0xffff, 0x0603, 0xffff, 0xffff, 0xffff, 0xffff,
+      0x024a, 0xffff, 0xffff, 0x006c, 0x000f, 0x06b3, 0xffff, 0x03c1, 0xffff, 0x0316, 0x06e8, 0x0261,
+      0xffff, 0xffff, 0x0512, 0xffff, 0x06eb, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff,
+      0x038a, 0xffff, 0x0502, 0x066d, 0xffff, 0xffff, 0xffff, 0xffff, 0x0532, 0xffff, 0x0228, 0x0094,
+      0x03d4, 0x0092, 0xffff, 0xffff, 0x079c, 0xffff, 0x0102, 0xffff, 0x043f, 0x0707, 0xffff, 0x024e,
+      0xffff, 0xffff, 0xffff, 0x0384, 0xffff, 0x0163, 0x0458, 0xffff, 0xffff, 0xffff, 0x0137, 0x03d1,
+      0xffff, 0x07e8, 0xffff, 0x016b, 0xffff, 0x00f6, 0x02b5, 0x030b, 0xffff, 0x0069, 0x0182, 0x01de,
+      0xffff, 0x0782, 0xffff, 0x0571, 0x07b9, 0xffff, 0xffff, 0x03ad, 0xffff, 0xffff, 0x05ad, 0x0660,
+      0x0229, 0xffff, 0xffff, 0x047f, 0xffff, 0x050d, 0x07c6, 0x03a5, 0xffff, 0x0494, 0x0455, 0x07a0,
+      0x0771, 0x00ca, 0x01ee, 0x0774, 0xffff, 0x03a8, 0x0422, 0x0297, 0xffff, 0x002d, 0x04fc, 0xffff,
+      0xffff, 0x0682, 0x04ae, 0xffff, 0xffff, 0x00d9, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x0449,
+      0xffff, 0xffff, 0xffff, 0xffff, 0x06b5, 0xffff, 0x04a4, 0xffff, 0xffff, 0x0394, 0x04b3, 0xffff,
+      0x03c4, 0xffff, 0x0487, 0xffff, 0x0589, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x04e7, 0x07a7,
+      0x03da, 0x03d3, 0xffff, 0xffff, 0xffff, 0x0452, 0xffff, 0x032e, 0xffff, 0x00ee, 0x0739, 0x049c,
+      0x07dc, 0xffff, 0xffff, 0xffff, 0xffff, 0x0296, 0x002a, 0x0067, 0xffff, 0xffff, 0xffff, 0xffff,
+      0x036b, 0xffff, 0x05c3, 0x00ff, 0xffff, 0x0395, 0xffff, 0xffff, 0x020e, 0xffff, 0x04f7, 0xffff,
+      0x048d, 0x05a6, 0xffff, 0x0785, 0x0755, 0x05aa, 0x0115, 0xffff, 0x0444, 0x01b3, 0x00bf, 0x0153,
+      0x022a, 0xffff, 0x022f, 0xffff, 0x0495, 0x02d8, 0x0594, 0x008e, 0x045a, 0x06c0, 0xffff, 0xffff,
+      0xffff, 0x00b6, 0x0412, 0xffff, 0xffff, 0xffff, 0x0206, 0xffff, 0xffff, 0xffff, 0xffff, 0x028c,
+      0xffff, 0xffff, 0x0227, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x02b9, 0xffff, 0x058b, 0xffff,
+      0x0652, 0xffff, 0x01f5, 0xffff, 0x0010, 0xffff, 0x06e2, 0xffff, 0xffff, 0xffff, 0xffff, 0x0712,
+      0x02be, 0xffff, 0xffff, 0x03b8, 0xffff, 0xffff, 0x0619, 0x07fd, 0x07d2, 0xffff, 0xffff, 0xffff,
+      0xffff, 0xffff, 0x0112, 0xffff, 0xffff, 0xffff, 0xffff, 0x01df, 0xffff, 0x02aa, 0xffff, 0xffff,
+      0x02b0, 0xffff, 0x02cc, 0x01ac, 0x02ac, 0xffff, 0xffff, 0x0794, 0x00d5, 0x06f4, 0xffff, 0xffff,
+      0xffff, 0xffff, 0x010e, 0xffff, 0x023f, 0xffff, 0xffff, 0x0274, 0x0390, 0xffff, 0x0349, 0xffff,
+      0xffff, 0xffff, 0xffff, 0x0439, 0xffff, 0x0280, 0xffff, 0xffff, 0xffff, 0xffff, 0x00dc, 0x014b,
+      0x0692, 0xffff, 0xffff, 0xffff, 0xffff, 0x079e, 0x079b, 0x0733, 0xffff, 0x00a0, 0xffff, 0xffff,
+      0xffff, 0xffff, 0xffff, 0x0501, 0xffff, 0xffff, 0xffff, 0x01e3, 0xffff, 0x045b, 0x065a, 0xffff,
+      0xffff, 0x03ba, 0x0209, 0x00ab, 0xffff, 0xffff, 0xffff, 0x0081, 0xffff, 0x019b, 0xffff, 0xffff,
+      0xffff, 0xffff, 0x0248, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x0622, 0xffff, 0xffff, 0xffff,
+      0xffff, 0x02a2, 0xffff, 0xffff, 0xffff, 0xffff, 0x056f, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff,
+      0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x051e, 0xffff, 0x031e, 0x05c1, 0xffff, 0x03e0,
+      0x04c0, 0xffff, 0x0244, 0xffff, 0xffff, 0xffff, 0x0257, 0x07b1, 0xffff, 0x0417, 0xffff, 0x0770,
+      0x0036, 0xffff, 0xffff, 0xffff, 0x0178, 0xffff, 0x0141, 0x0430, 0x000b, 0xffff, 0x06f2, 0x065f,
+      0xffff, 0x06e0, 0x01c9, 0x0428, 0x0211, 0xffff, 0xffff, 0x05c0, 0xffff, 0x042c, 0x0037, 0x0668,
+      0x0703, 0x06f5, 0x050f, 0x002f, 0x01f6, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x0743, 0x004a,
+      0x06d6, 0xffff, 0x048b, 0xffff, 0xffff, 0xffff, 0x0738, 0x037a, 0xffff, 0xffff, 0xffff, 0x0374,
+      0xffff, 0xffff, 0x0140, 0xffff, 0xffff, 0x00d1, 0x0784, 0x07a8, 0xffff, 0x03e2, 0x02d9, 0x0020,
+      0x0780, 0xffff, 0x056e, 0x0665, 0x06cb, 0xffff, 0xffff, 0x010b, 0x06b8, 0x07a4, 0xffff, 0xffff,
+      0x03cd, 0x0212, 0xffff, 0xffff, 0xffff, 0x0050, 0xffff, 0x00e4, 0x0362, 0xffff, 0xffff, 0x04cb,
+      0x014c, 0xffff, 0x01c4, 0xffff, 0xffff, 0x0287, 0xffff, 0xffff, 0x076a, 0x0200, 0xffff, 0xffff,
+      0x07ba, 0x0250, 0x03e8, 0xffff, 0xffff, 0x0372, 0xffff, 0x058c, 0xffff, 0xffff, 0x0554, 0xffff,
+      0x0063, 0x06be, 0x0584, 0xffff, 0xffff, 0xffff, 0x0726, 0x01fc, 0xffff, 0x04e1, 0xffff, 0x031b,
+      0xffff, 0x051d, 0x01f4, 0xffff, 0x0691, 0x013b, 0xffff, 0x0241, 0x0581, 0x0648, 0x0468, 0x015a,
+      0x050e, 0xffff, 0xffff, 0x049d, 0xffff, 0x0146, 0xffff, 0xffff, 0x0659, 0x0272, 0x0702, 0xffff,
+      0xffff, 0xffff, 0x04ac, 0x01f3, 0xffff, 0xffff, 0x04e4, 0x034b, 0x063a, 0xffff, 0xffff, 0x002b,
+      0x0629, 0x07a5, 0x02bd, 0xffff, 0x00aa, 0xffff, 0xffff, 0x0644, 0x01b5, 0xffff, 0x06fd, 0xffff,
+      0xffff, 0xffff, 0xffff, 0x000a, 0x0776, 0xffff, 0x0586, 0xffff, 0xffff, 0xffff, 0x057d, 0xffff,
+      0xffff, 0x01f9, 0xffff, 0x04d9, 0xffff, 0x025d, 0x06de, 0xffff, 0xffff, 0x04d3, 0x01b6, 0xffff,
+      0xffff, 0x01c0, 0xffff, 0x0443, 0xffff, 0x037c, 0x06ac, 0xffff, 0x07e2, 0xffff, 0xffff, 0x02fa,
+      0xffff, 0xffff, 0x04d2, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x0128, 0xffff, 0x05ea,
+      0xffff, 0x0344, 0xffff, 0xffff, 0x0139, 0x0541, 0xffff, 0x03ff, 0xffff, 0x035a, 0xffff, 0xffff,
+      0xffff, 0x0690, 0xffff, 0x0696, 0xffff, 0xffff, 0xffff, 0x01dd, 0xffff, 0xffff, 0xffff, 0xffff,
+      0xffff, 0xffff, 0x04af, 0xffff, 0x0723, 0x029b, 0xffff, 0xffff, 0xffff, 0x06fa, 0x0593, 0xffff,
+      0xffff, 0xffff, 0x00b4, 0x02da, 0x000e, 0xffff, 0xffff, 0x012f, 0x057e, 0xffff, 0xffff, 0x0574,
+      0x038b, 0xffff, 0x00a2, 0x0313, 0xffff, 0xffff, 0x0669, 0x007c, 0xffff, 0xffff, 0x07fe, 0x00af,
+      0x07b7, 0x00f5, 0xffff, 0x030a, 0xffff, 0xffff, 0x04ff, 0xffff, 0xffff, 0x001a, 0xffff, 0x074a,
+      0xffff, 0xffff, 0xffff, 0x0221, 0xffff, 0x04c1, 0x06cc, 0x00c5, 0x04e0, 0xffff, 0x062b, 0x072e,
+      0xffff, 0x046c, 0x0293, 0x0154, 0x0142, 0xffff, 0x0145, 0xffff, 0xffff, 0xffff, 0x00f7, 0xffff,
+      0xffff, 0x0649, 0x06df, 0x002c, 0x00ed, 0xffff, 0xffff, 0xffff, 0x04bd, 0x07a2, 0xffff, 0x04de,
+      0xffff, 0x07cd, 0xffff, 0xffff, 0x05e9, 0xffff, 0xffff, 0xffff, 0x022d, 0x0730, 0x04f5, 0x0793,
+      0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x0486, 0xffff, 0x039b, 0x0072, 0xffff, 0x05ed, 0x0121,
+      0x04df, 0x07bb, 0xffff, 0x06ef, 0x05e0, 0xffff, 0xffff, 0x05cd, 0x0144, 0x0264, 0x076c, 0x000c,
+      0xffff, 0xffff, 0x0613, 0x053d, 0x06a2, 0xffff, 0xffff, 0xffff, 0xffff, 0x068a, 0x0527, 0xffff,
+      0xffff, 0x0674, 0x01b8, 0xffff, 0xffff, 0x0351, 0x064c, 0xffff, 0xffff, 0xffff, 0xffff, 0x05b7,
+      0x0788, 0xffff, 0xffff, 0xffff, 0x0236, 0x0127, 0xffff, 0xffff, 0xffff, 0x0234, 0xffff, 0x060e,
+      0x075a, 0xffff, 0x0179, 0x0334, 0xffff, 0xffff, 0x01b0, 0xffff, 0xffff, 0xffff, 0x07ff, 0x064b,
+      0xffff, 0xffff, 0x05ec, 0x061a, 0xffff, 0xffff, 0xffff, 0x06fb, 0x0284, 0xffff, 0x054a, 0xffff,
+      0xffff, 0xffff, 0x0237, 0xffff, 0x021e, 0xffff, 0xffff, 0x0538, 0x04ef, 0xffff, 0x0230, 0x06b4,
+      0xffff, 0xffff, 0x0549, 0x0089, 0xffff, 0xffff, 0x0744, 0xffff, 0x077a, 0xffff, 0x00ae, 0x0012,
+      0x051c, 0xffff, 0x0407, 0x07e5, 0x0213, 0xffff, 0xffff, 0x038c, 0x03c3, 0x070f, 0xffff, 0x0515,
+      0xffff, 0x00fc, 0xffff, 0xffff, 0x06ab, 0x0017, 0x00c3, 0x07c5, 0x06c7, 0x02df, 0xffff, 0xffff,
+      0xffff, 0xffff, 0x0618, 0xffff, 0x0710, 0xffff, 0x05d8, 0xffff, 0xffff, 0xffff, 0x0456, 0x0511,
+      0xffff, 0x0411, 0xffff, 0x075c, 0x010f, 0x0086, 0xffff, 0xffff, 0x0500, 0xffff, 0x049a, 0xffff,
+      0xffff, 0x07ca, 0x03d8, 0x06bb, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x0343, 0x01cd,
+      0xffff, 0x067c, 0xffff, 0xffff, 0x0026, 0x029d, 0x020b, 0x0306, 0x0715, 0xffff, 0x07c8, 0xffff,
+      0xffff, 0x017e, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x064e, 0x01a7, 0x0105, 0x05c2, 0x0564,
+      0x064f, 0xffff, 0x01ad, 0x031f, 0x06dd, 0x0447, 0x059f, 0x0732, 0xffff, 0x00d2, 0x0533, 0x046b,
+      0xffff, 0x01c3, 0xffff, 0x05a2, 0x0007, 0xffff, 0xffff, 0x02f0, 0xffff, 0xffff, 0xffff, 0xffff,
+      0x0526, 0xffff, 0xffff, 0xffff, 0x0110, 0x0134, 0xffff, 0xffff, 0x037b, 0xffff, 0xffff, 0xffff,
+      0xffff, 0x003a, 0xffff, 0xffff, 0x0676, 0x05cc, 0x0304, 0xffff, 0x03bb, 0xffff, 0xffff, 0x0698,
+      0xffff, 0xffff, 0x0747, 0x0530, 0x0781, 0xffff, 0x066c, 0xffff, 0x02a0, 0x0677, 0xffff, 0x077d,
+      0xffff, 0xffff, 0x04a0, 0x0471, 0xffff, 0x01af, 0xffff, 0x0524, 0x00e0, 0xffff, 0x0245, 0xffff,
+      0x016f, 0xffff, 0x05be, 0xffff, 0x0548, 0x038d, 0x0130, 0xffff, 0xffff, 0xffff, 0xffff, 0x0096,
+      0xffff, 0x004c, 0x011b, 0xffff, 0x0210, 0x07fa, 0x0131, 0x0666, 0xffff, 0xffff, 0xffff, 0xffff,
+      0x0353, 0xffff, 0x0480, 0x0731, 0xffff, 0x02f8, 0xffff, 0xffff, 0x0655, 0xffff, 0xffff, 0xffff,
+      0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x05d1, 0x0354, 0x05c5, 0x0474, 0x071f, 0xffff, 0x07e4,
+      0xffff, 0xffff, 0x0040, 0x01a8, 0xffff, 0x0573, 0xffff, 0x06aa, 0xffff, 0x0367, 0xffff, 0xffff,
+      0xffff, 0x035b, 0xffff, 0x03e1, 0xffff, 0x0332, 0xffff, 0x06c8, 0x0572, 0xffff, 0xffff, 0x04d5,
+      0xffff, 0xffff, 0x013c, 0x06a0, 0x06c1, 0xffff, 0x0192, 0x0195, 0xffff, 0x072d, 0xffff, 0x04a2,
+      0xffff, 0xffff, 0x005e, 0x047d, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x0598,
+      0x01f7, 0xffff, 0x07ed, 0x074e, 0x00de, 0x0278, 0xffff, 0xffff, 0xffff, 0xffff, 0x0607, 0x07f0,
+      0xffff, 0x05e5, 0xffff, 0xffff, 0xffff, 0x01bc, 0xffff, 0x063b, 0xffff, 0xffff, 0x02b7, 0x016a,
+      0x05b9, 0x03e3, 0x017b, 0x03bd, 0xffff, 0x004d, 0x047b, 0x0298, 0xffff, 0x0216, 0xffff, 0xffff,
+      0x00e2, 0x0508, 0x01e9, 0xffff, 0xffff, 0x0740, 0xffff, 0xffff, 0xffff, 0x0577, 0x0071, 0x0638,
+      0xffff, 0x02ec, 0x0599, 0x00e1, 0x03a4, 0x053a, 0x048a, 0x027f, 0xffff, 0xffff, 0x055f, 0x0725,
+      0xffff, 0x0175, 0xffff, 0x036c, 0xffff, 0x060d, 0x0138, 0x0482, 0x0795, 0x055d, 0xffff, 0x0514,
+      0xffff, 0xffff, 0xffff, 0xffff, 0x05e7, 0x0030, 0xffff, 0x04a5, 0xffff, 0xffff, 0xffff, 0x04c7,
+      0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x0019, 0x0529, 0xffff, 0x0188, 0x0448, 0xffff,
+      0x03c7, 0xffff, 0xffff, 0xffff, 0x0591, 0xffff, 0x029f, 0xffff, 0xffff, 0x0758, 0x0679, 0xffff,
+      0x00ac, 0xffff, 0x0275, 0x052d, 0xffff, 0x0095, 0x054b, 0x06ec, 0x0377, 0xffff, 0x038f, 0xffff,
+      0x01c1, 0xffff, 0xffff, 0x03f0, 0x00a9, 0x076d, 0xffff, 0x0325, 0x04d7, 0x0440, 0x04d6, 0xffff,
+      0x04b4, 0xffff, 0x0232, 0xffff, 0xffff, 0xffff, 0x0259, 0xffff, 0x04f2, 0xffff, 0x0427, 0xffff,
+      0xffff, 0x0787, 0x05ac, 0xffff, 0xffff, 0x02c0, 0xffff, 0x0324, 0x0786, 0x01e6, 0x039d, 0x02ca,
+      0x066e, 0xffff, 0x02b6, 0x02f9, 0x02ed, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff,
+      0xffff, 0xffff, 0xffff, 0xffff, 0x01d2, 0x0466, 0x03b0, 0x069f, 0x048e, 0x04cd, 0x077c, 0xffff,
+      0xffff, 0x05bc, 0x07be, 0x012a, 0x0215, 0x073e, 0xffff, 0xffff, 0xffff, 0xffff, 0x0510, 0xffff,
+      0xffff, 0x02b2, 0x021a, 0xffff, 0xffff, 0x05da, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x001e,
+      0x03e6, 0xffff, 0x001b, 0x020c, 0x0338, 0x05db, 0x01b9, 0x0186, 0x04cf, 0x0779, 0x07e9, 0xffff,
+      0xffff, 0x07e1, 0xffff, 0xffff, 0x04e3, 0x036d, 0xffff, 0xffff, 0x01e1, 0x078c, 0x03de, 0x011d,
+      0x070a, 0x066f, 0x0074, 0xffff, 0x05d2, 0x071d, 0x04d0, 0x07d8, 0xffff, 0x06f0, 0x02a8, 0xffff,
+      0x02a9, 0x035d, 0xffff, 0x03f8, 0x035c, 0x0340, 0x0777, 0xffff, 0x03c6, 0xffff, 0xffff, 0x0653,
+      0x057c, 0xffff, 0xffff, 0xffff, 0xffff, 0x02f3, 0xffff, 0xffff, 0x044c, 0xffff, 0xffff, 0xffff,
+      0xffff, 0xffff, 0x06c2, 0xffff, 0x076e, 0xffff, 0x0122, 0x040c, 0xffff, 0x0160, 0xffff, 0x029c,
+      0x0516, 0xffff, 0xffff, 0xffff, 0xffff, 0x0540, 0xffff, 0x0167, 0x07dd, 0xffff, 0x07cb, 0x055a,
+      0xffff, 0x0161, 0xffff, 0x0796, 0xffff, 0xffff, 0xffff, 0x005d, 0x03d5, 0x0409, 0xffff, 0xffff,
+      0xffff, 0x0664, 0x058a, 0x0191, 0xffff, 0x06f8, 0x06f7, 0xffff, 0x05d6, 0x0172, 0x03aa, 0xffff,
+      0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x0369, 0xffff, 0x05f6, 0x0568, 0x0057, 0xffff,
+      0xffff, 0x044b, 0xffff, 0x02c6, 0x0552, 0x006b, 0x0597, 0xffff, 0x070c, 0xffff, 0xffff, 0x050c,
+      0x05fa, 0x007d, 0x0308, 0x05a4, 0xffff, 0x06f1, 0xffff, 0xffff, 0x06c5, 0x0292, 0x001f, 0xffff,
+      0x04a7, 0x06e4, 0x02e7, 0xffff, 0xffff, 0x048c, 0x0147, 0x0630, 0x071b, 0x019a, 0xffff, 0x0550,
+      0x01e5, 0xffff, 0x05e1, 0x0098, 0xffff, 0x07a1, 0xffff, 0xffff, 0x0489, 0xffff, 0x03b7, 0xffff,
+      0xffff, 0x0342, 0xffff, 0x033d, 0x0168, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x0476, 0x04bf,
+      0x0099, 0xffff, 0x02d7, 0xffff, 0x00cf, 0x07cf, 0x0143, 0xffff, 0xffff, 0xffff, 0x01ec, 0xffff,
+      0x025b, 0xffff, 0x03a9, 0xffff, 0x0347, 0x0155, 0xffff, 0xffff, 0xffff, 0x07eb, 0x0764, 0x053e,
+      0x0484, 0x0464, 0x060b, 0xffff, 0x02fb, 0x02e9, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff,
+      0x05e2, 0x07e6, 0x0258, 0x0171, 0x0044, 0x020a, 0xffff, 0xffff, 0xffff, 0x00ec, 0xffff, 0xffff,
+      0x05b0, 0xffff, 0xffff, 0xffff, 0x07bf, 0x0492, 0xffff, 0xffff, 0x0289, 0x075b, 0x042a, 0x0558,
+      0x037f, 0x01f2, 0x0059, 0xffff, 0xffff, 0x0798, 0xffff, 0xffff, 0x0410, 0x077e, 0x0493, 0x0345,
+      0x039e, 0xffff, 0xffff, 0xffff, 0xffff, 0x04c3, 0xffff, 0xffff, 0x0385, 0xffff, 0x02cd, 0xffff,
+      0xffff, 0xffff, 0xffff, 0x07de, 0x03c9, 0x025e, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x0029,
+      0xffff, 0xffff, 0x072c, 0x049f, 0xffff, 0xffff, 0x05b2, 0xffff, 0x0559, 0xffff, 0xffff, 0xffff,
+      0x02e3, 0x059d, 0xffff, 0xffff, 0x0436, 0x02f6, 0x05e4, 0xffff, 0x0109, 0xffff, 0xffff, 0xffff,
+      0x01fb, 0xffff, 0x030c, 0xffff, 0xffff, 0x05a1, 0xffff, 0x026d, 0x0271, 0x0711, 0x06ce, 0xffff,
+      0xffff, 0x02de, 0xffff, 0xffff, 0xffff, 0xffff, 0x0309, 0x0028, 0xffff, 0x07db, 0x0021, 0xffff,
+      0x062a, 0xffff, 0x010c, 0xffff, 0x065d, 0x079a, 0xffff, 0xffff, 0xffff, 0x0654, 0x0283, 0x027b,
+      0x0032, 0x0697, 0x01d6, 0xffff, 0x00d3, 0xffff, 0xffff, 0xffff, 0x016d, 0x0240, 0xffff, 0xffff,
+      0xffff, 0xffff, 0xffff, 0x0052, 0xffff, 0x06d9, 0x00c4, 0x0749, 0xffff, 0x03eb, 0xffff, 0x04b1,
+      0xffff, 0x03f7, 0xffff, 0x0239, 0x01c7, 0xffff, 0x07a9, 0x01ff, 0x014a, 0xffff, 0x0590, 0x0199,
+      0x0667, 0x0108, 0xffff, 0xffff, 0x072f, 0xffff, 0x0647, 0xffff, 0x06ff, 0x04e5, 0xffff, 0x07c9,
+      0x0683, 0xffff, 0x06bc, 0x0252, 0xffff, 0xffff, 0xffff, 0xffff, 0x0045, 0x03dd, 0xffff, 0x07b0,
+      0x0693, 0x07c1, 0xffff, 0x01ab, 0xffff, 0x0048, 0x01ba, 0xffff, 0x0120, 0xffff, 0xffff, 0x0721,
+      0xffff, 0x0103, 0x0543, 0x04f1, 0x06a9, 0x0214, 0x05d7, 0xffff, 0x0135, 0xffff, 0x03a6, 0xffff,
+      0xffff, 0x06ba, 0xffff, 0xffff, 0xffff, 0x0364, 0x0402, 0xffff, 0x02e1, 0x00cd, 0x041a, 0x011f,
+      0x01bf, 0xffff, 0xffff, 0x07f8, 0xffff, 0xffff, 0x03ae, 0x0253, 0x01e0, 0x0311, 0x07b4, 0x042b,
+      0x04a9, 0xffff, 0xffff, 0x076f, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x00a1, 0x0268, 0xffff,
+      0xffff, 0x0575, 0xffff, 0xffff, 0x05dd, 0xffff, 0xffff, 0xffff, 0x02ad, 0x04ba, 0xffff, 0xffff,
+      0xffff, 0x015c, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x05bd, 0x045d, 0x022c, 0xffff, 0x069e,
+      0xffff, 0x056a, 0x0386, 0xffff, 0xffff, 0x06b6, 0xffff, 0xffff, 0x045f, 0x03b3, 0xffff, 0xffff,
+      0x06d0, 0xffff, 0x00c7, 0x0419, 0xffff, 0xffff, 0xffff, 0x03df, 0xffff, 0x0450, 0x0314, 0x011e,
+      0x0004, 0xffff, 0xffff, 0x03af, 0xffff, 0x0719, 0xffff, 0x033e, 0x031d, 0xffff, 0x0194, 0x0605,
+      0xffff, 0x012c, 0x047a, 0x0587, 0x04db, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x03ab,
+      0xffff, 0x073b, 0x0132, 0xffff, 0x0339, 0x04eb, 0xffff, 0x053b, 0xffff, 0x0724, 0x044d, 0x03ed,
+      0xffff, 0xffff, 0x0277, 0x02d0, 0x0359, 0x0588, 0x0481, 0xffff, 0xffff, 0xffff, 0x02c8, 0xffff,
+      0xffff, 0x01da, 0xffff, 0x07ec, 0xffff, 0xffff, 0xffff, 0x04b2, 0x0640, 0x0563, 0xffff, 0x0426,
+      0x01a9, 0xffff, 0xffff, 0x06a8, 0x00b3, 0xffff, 0xffff, 0x05bb, 0xffff, 0x03ec, 0x03c0, 0x06b9,
+      0x01a0, 0x05b4, 0xffff, 0xffff, 0x0065, 0x00ba, 0x0627, 0x00bc, 0xffff, 0x027c, 0xffff, 0x02e4,
+      0x028f, 0xffff, 0xffff, 0x02a5, 0xffff, 0x0370, 0xffff, 0x02b1, 0x03b1, 0x05fe, 0xffff, 0x0643,
+      0xffff, 0xffff, 0xffff, 0x0433, 0x07d0, 0x07c0, 0x01eb, 0xffff, 0xffff, 0xffff, 0x0734, 0x019e,
+      0xffff, 0xffff, 0x03b9, 0xffff, 0x0070, 0xffff, 0x00c6, 0x01d1, 0x034d, 0xffff, 0xffff, 0x02bb,
+      0x0113, 0xffff, 0x07f2, 0x0119, 0xffff, 0xffff, 0x0170, 0x03b2, 0xffff, 0x0326, 0x052b, 0x0068,
+      0x05fb, 0x04ad, 0x017a, 0xffff, 0xffff, 0x0266, 0xffff, 0xffff, 0x02d1, 0xffff, 0xffff, 0xffff,
+      0xffff, 0x015f, 0xffff, 0xffff, 0xffff, 0xffff, 0x0379, 0xffff, 0xffff, 0x052c, 0xffff, 0x06b0,
+      0xffff, 0x05b8, 0xffff, 0x02ce, 0x00cb, 0x05a0, 0x0285, 0x0400, 0x042d, 0xffff, 0xffff, 0xffff,
+      0xffff, 0x0333, 0x04bc, 0x063f, 0x02db, 0xffff, 0x0361, 0xffff, 0x003e, 0x0251, 0xffff, 0xffff,
+      0x0321, 0xffff, 0xffff, 0xffff, 0xffff, 0x034e, 0xffff, 0x037d, 0x033a, 0xffff, 0xffff, 0x0765,
+      0xffff, 0xffff, 0x024d, 0xffff, 0x0760, 0x026e, 0xffff, 0x0539, 0x022b, 0xffff, 0xffff, 0xffff,
+      0x0736, 0xffff, 0xffff, 0x0628, 0xffff, 0xffff, 0x0358, 0x0791, 0xffff, 0xffff, 0xffff, 0xffff,
+      0x0465, 0xffff, 0x020d, 0xffff, 0x02d2, 0xffff, 0xffff, 0x0225, 0x0150, 0xffff, 0x0106, 0xffff,
+      0x0281, 0x0565, 0xffff, 0x075f, 0xffff, 0x00e5, 0x0542, 0x00a7, 0x0713, 0xffff, 0xffff, 0x0023,
+      0xffff, 0x02d3, 0xffff, 0xffff, 0xffff, 0x0416, 0x009f, 0x0604, 0xffff, 0xffff, 0x01cb, 0x02e8,
+      0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x0151, 0xffff, 0x0491, 0xffff, 0xffff, 0xffff, 0xffff,
+      0x0437, 0x077f, 0x03cc, 0x0728, 0xffff, 0x00c8, 0xffff, 0x07c2, 0xffff, 0xffff, 0x0553, 0xffff,
+      0xffff, 0x0609, 0x003b, 0x03b6, 0x0181, 0xffff, 0x069b, 0xffff, 0xffff, 0x04e8, 0xffff, 0x0337,
+      0x0093, 0xffff, 0x0299, 0xffff, 0x0062, 0xffff, 0x0126, 0x05d5, 0x0778, 0xffff, 0xffff, 0x0485,
+      0xffff, 0x0016, 0x0757, 0x003d, 0xffff, 0x01ce, 0x03a7, 0x039c, 0xffff, 0x057a, 0x01d5, 0x0610,
+      0x0217, 0x040f, 0xffff, 0xffff, 0x0329, 0x02f4, 0x0022, 0xffff, 0x0061, 0xffff, 0x03b5, 0x0752,
+      0x04c8, 0x043a, 0x045e, 0x063e, 0x07b8, 0xffff, 0xffff, 0xffff, 0x0596, 0xffff, 0xffff, 0x073d,
+      0x022e, 0x0401, 0xffff, 0x0462, 0xffff, 0xffff, 0xffff, 0xffff, 0x0418, 0xffff, 0xffff, 0x0242,
+      0x06fe, 0x0768, 0x060f, 0xffff, 0xffff, 0xffff, 0xffff, 0x06dc, 0x05d9, 0x07b3, 0xffff, 0x027d,
+      0x0592, 0xffff, 0x008a, 0xffff, 0xffff, 0x007b, 0xffff, 0x01cc, 0xffff, 0x00fe, 0xffff, 0xffff,
+      0xffff, 0x011c, 0x02f5, 0x02ea, 0x069a, 0x0262, 0xffff, 0x07a6, 0xffff, 0xffff, 0xffff, 0x03dc,
+      0xffff, 0xffff, 0x021f, 0x0011, 0x0631, 0xffff, 0xffff, 0x00d6, 0xffff, 0x04d8, 0xffff, 0xffff,
+      0x0198, 0xffff, 0x0204, 0x0393, 0xffff, 0x0488, 0xffff, 0x0498, 0x0350, 0xffff, 0xffff, 0x0772,
+      0xffff, 0x065b, 0xffff, 0xffff, 0x07c4, 0x012e, 0xffff, 0x0746, 0xffff, 0x0528, 0x07b2, 0x0307,
+      0xffff, 0xffff, 0x0431, 0x00c0, 0xffff, 0xffff, 0xffff, 0x01b7, 0xffff, 0x018e, 0xffff, 0xffff,
+      0xffff, 0x0238, 0x0775, 0x0420, 0x05f9, 0xffff, 0x03e9, 0xffff, 0xffff, 0x0569, 0x069c, 0xffff,
+      0xffff, 0xffff, 0x003f, 0x055e, 0x02f1, 0x0058, 0x0219, 0xffff, 0xffff, 0x07e3, 0x03c2, 0x03fb,
+      0x0646, 0x04a6, 0x075d, 0xffff, 0x0656, 0x05bf, 0xffff, 0xffff, 0xffff, 0x036e, 0x00ce, 0x0753,
+      0x073c, 0xffff, 0x0049, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x0716, 0xffff, 0x05b6, 0x0380,
+      0xffff, 0x0396, 0x0503, 0xffff, 0x02e6, 0xffff, 0xffff, 0x029a, 0xffff, 0xffff, 0xffff, 0xffff,
+      0xffff, 0xffff, 0x0100, 0x0424, 0x07bc, 0x008b, 0xffff, 0x0054, 0x059b, 0xffff, 0xffff, 0x00d8,
+      0x070d, 0x032c, 0xffff, 0xffff, 0x04c2, 0xffff, 0x0762, 0x0432, 0xffff, 0x041b, 0xffff, 0x0046,
+      0x06b1, 0x02c5, 0xffff, 0x074c, 0x0531, 0x01d9, 0x0310, 0x060a, 0xffff, 0x0445, 0xffff, 0xffff,
+      0x05f1, 0x07aa, 0xffff, 0x01fd, 0xffff, 0x0246, 0x052e, 0x043c, 0xffff, 0xffff, 0x010d, 0x0136,
+      0xffff, 0x0718, 0x0661, 0xffff, 0xffff, 0xffff, 0x061b, 0xffff, 0x0047, 0x0790, 0x0080, 0x031c,
+      0x0672, 0x0397, 0xffff, 0x0033, 0xffff, 0x0082, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x056c,
+      0xffff, 0xffff, 0xffff, 0xffff, 0x049e, 0xffff, 0xffff, 0x013e, 0xffff, 0x0681, 0xffff, 0xffff,
+      0x0003, 0x008c, 0x06da, 0x078e, 0x0751, 0x053f, 0xffff, 0x01fa, 0xffff, 0x01ea, 0xffff, 0xffff,
+      0xffff, 0x0688, 0xffff, 0xffff, 0x046d, 0xffff, 0xffff, 0xffff, 0x07ae, 0xffff, 0x0602, 0x0595,
+      0xffff, 0x04b9, 0xffff, 0xffff, 0x00c9, 0xffff, 0x03f6, 0x02ee, 0xffff, 0x05b3, 0x068f, 0xffff,
+      0xffff, 0x01d4, 0x0202, 0xffff, 0xffff, 0x071a, 0x024f, 0xffff, 0xffff, 0xffff, 0x04cc, 0x015d,
+      0x0152, 0xffff, 0xffff, 0x0348, 0xffff, 0x066b, 0xffff, 0x0671, 0x054e, 0x0346, 0x0421, 0xffff,
+      0x0341, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x0009, 0x06af, 0xffff, 0xffff, 0xffff, 0x07ac,
+      0x06ca, 0xffff, 0xffff, 0x02a7, 0xffff, 0x0767, 0xffff, 0x003c, 0x06cd, 0xffff, 0x06fc, 0x04b6,
+      0xffff, 0xffff, 0xffff, 0xffff, 0x06c9, 0x0404, 0x0763, 0x035f, 0x06d3, 0x00b5, 0x0300, 0x0525,
+      0xffff, 0xffff, 0x02c1, 0xffff, 0xffff, 0xffff, 0x0352, 0xffff, 0xffff, 0x072a, 0xffff, 0xffff,
+      0xffff, 0x062e, 0x06d5, 0x057f, 0xffff, 0x02fe, 0xffff, 0xffff, 0xffff, 0x010a, 0xffff, 0x0536,
+      0x0327, 0xffff, 0xffff, 0xffff, 0x00be, 0xffff, 0x0336, 0xffff, 0xffff, 0x02a6, 0xffff, 0xffff,
+      0xffff, 0x013a, 0x0355, 0x0600, 0xffff, 0x0506, 0xffff, 0xffff, 0x0331, 0xffff, 0xffff, 0x033f,
+      0xffff, 0xffff, 0x009a, 0x039f, 0x04f6, 0x0413, 0x02e2, 0xffff, 0xffff, 0xffff, 0x00c2, 0xffff,
+      0xffff, 0xffff, 0x06ed, 0xffff, 0x06c4, 0x07d4, 0x0467, 0x00fa, 0xffff, 0x0438, 0x00f0, 0x07ee,
+      0xffff, 0xffff, 0x01c2, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0x05c7, 0x009b, 0x03e4,
+      0x0617, 0xffff, 0x05ca, 0xffff, 0x032d, 0x049b, 0xffff, 0xffff, 0x02bf, 0x06d1, 0xffff, 0xffff,
+      0x016e, 0xffff, 0x061e, 0xffff, 0xffff, 0xffff, 0x01dc, 0xffff, 0x0463, 0x04ab, 0xffff, 0x01d3,
+      0x03f4, 0x03f3, 0x05eb, 0x0625
+    };
+
+    constexpr std::uint32_t slot(const std::uint32_t key) noexcept
+    {
+      return mix(key ^ displacement[bucket(key)]) >> (32 - slot_bits);
+    }
+
+    //! \return Candidate `word_list` index for `key`, or `empty`.
+    constexpr std::uint16_t find(const std::uint32_t key) noexcept
+    {
+      return slots[slot(key)];
+    }
+
+    //! Binary recursion keeps constexpr depth at log(N) in C++11.
+    constexpr bool check(const std::size_t begin, const std::size_t end)
+    {
+      return end - begin == 1 ?
+        find(key(word_list[begin])) == begin :
+        check(begin, begin + (end - begin) / 2) && check(begin + (end - begin) / 2, end);
+    }
+
+    static_assert(check(0, 2048), "perfect hash tables do not match word_list");
+  } // word_hash
+} // bip39
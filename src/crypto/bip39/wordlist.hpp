@@ -25,7 +25,7 @@
 
 namespace bip39
 {
-  const char* const word_list[2048] = {
+  constexpr const char* const word_list[2048] = {
     "abandon",  "ability",  "able",     "about",    "above",    "absent",
     "absorb",   "abstract", "absurd",   "abuse",    "access",   "accident",
     "account",  "accuse",   "achieve",  "acid",     "acoustic", "acquire",
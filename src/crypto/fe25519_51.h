@@ -0,0 +1,294 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef crypto_fe25519_51_H
+#define crypto_fe25519_51_H
+
+/* GF(2^255 - 19) with five 51-bit limbs and 64x64->128 bit multiplies,
+   shared by the X25519 ladder and the fixed-base kernel. Every function runs
+   the same instruction sequence for any input. Internal to `src/crypto`.
+
+   Limb bounds: `fe51_mul`/`fe51_sq` accept limbs below 2^54 and return
+   carried limbs (below 2^51 + 2^13). `fe51_sub` needs a carried `g`. */
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SIZEOF_INT128__)
+
+typedef unsigned __int128 uint128_t;
+typedef uint64_t fe51[5];
+
+#define MASK51 ((((uint64_t) 1) << 51) - 1)
+
+static inline uint64_t
+load64_le(const unsigned char src[8])
+{
+    uint64_t w;
+    memcpy(&w, src, sizeof w); /* configure requires little endian */
+    return w;
+}
+
+static inline void
+fe51_frombytes(fe51 h, const unsigned char s[32])
+{
+    const uint64_t w0 = load64_le(s);
+    const uint64_t w1 = load64_le(s + 8);
+    const uint64_t w2 = load64_le(s + 16);
+    const uint64_t w3 = load64_le(s + 24);
+
+    h[0] = w0 & MASK51;
+    h[1] = ((w0 >> 51) | (w1 << 13)) & MASK51;
+    h[2] = ((w1 >> 38) | (w2 << 26)) & MASK51;
+    h[3] = ((w2 >> 25) | (w3 << 39)) & MASK51;
+    h[4] = (w3 >> 12) & MASK51; /* top bit ignored, RFC 7748 */
+}
+
+//! Weak reduction; output limbs < 2^51 + 2^13 (limb 0 slightly larger).
+static inline void
+fe51_carry(fe51 h)
+{
+    uint64_t c;
+
+    c = h[0] >> 51; h[0] &= MASK51; h[1] += c;
+    c = h[1] >> 51; h[1] &= MASK51; h[2] += c;
+    c = h[2] >> 51; h[2] &= MASK51; h[3] += c;
+    c = h[3] >> 51; h[3] &= MASK51; h[4] += c;
+    c = h[4] >> 51; h[4] &= MASK51; h[0] += 19 * c;
+    c = h[0] >> 51; h[0] &= MASK51; h[1] += c;
+}
+
+static inline void
+fe51_tobytes(unsigned char s[32], const fe51 f)
+{
+    fe51     h;
+    uint64_t q;
+
+    memcpy(h, f, sizeof h);
+    fe51_carry(h);
+
+    /* h < 2p; subtract p iff h + 19 >= 2^255 */
+    q = (h[0] + 19) >> 51;
+    q = (h[1] + q) >> 51;
+    q = (h[2] + q) >> 51;
+    q = (h[3] + q) >> 51;
+    q = (h[4] + q) >> 51;
+
+    h[0] += 19 * q;
+    h[1] += h[0] >> 51; h[0] &= MASK51;
+    h[2] += h[1] >> 51; h[1] &= MASK51;
+    h[3] += h[2] >> 51; h[2] &= MASK51;
+    h[4] += h[3] >> 51; h[3] &= MASK51;
+    h[4] &= MASK51;
+
+    q = h[0] | (h[1] << 51);
+    memcpy(s, &q, 8);
+    q = (h[1] >> 13) | (h[2] << 38);
+    memcpy(s + 8, &q, 8);
+    q = (h[2] >> 26) | (h[3] << 25);
+    memcpy(s + 16, &q, 8);
+    q = (h[3] >> 39) | (h[4] << 12);
+    memcpy(s + 24, &q, 8);
+}
+
+static inline void
+fe51_add(fe51 h, const fe51 f, const fe51 g)
+{
+    h[0] = f[0] + g[0];
+    h[1] = f[1] + g[1];
+    h[2] = f[2] + g[2];
+    h[3] = f[3] + g[3];
+    h[4] = f[4] + g[4];
+}
+
+//! `h = f - g + 2p`, so limbs stay positive for carried `g`.
+static inline void
+fe51_sub(fe51 h, const fe51 f, const fe51 g)
+{
+    h[0] = (f[0] + 0xfffffffffffdaULL) - g[0];
+    h[1] = (f[1] + 0xffffffffffffeULL) - g[1];
+    h[2] = (f[2] + 0xffffffffffffeULL) - g[2];
+    h[3] = (f[3] + 0xffffffffffffeULL) - g[3];
+    h[4] = (f[4] + 0xffffffffffffeULL) - g[4];
+}
+
+//! `h = f - g + 4p`, for `g` with limbs up to 2^53 (one add or sub).
+static inline void
+fe51_sub_wide(fe51 h, const fe51 f, const fe51 g)
+{
+    h[0] = (f[0] + 0x1fffffffffffb4ULL) - g[0];
+    h[1] = (f[1] + 0x1ffffffffffffcULL) - g[1];
+    h[2] = (f[2] + 0x1ffffffffffffcULL) - g[2];
+    h[3] = (f[3] + 0x1ffffffffffffcULL) - g[3];
+    h[4] = (f[4] + 0x1ffffffffffffcULL) - g[4];
+}
+
+static inline void
+fe51_reduce128(fe51 h, uint128_t r0, uint128_t r1, uint128_t r2,
+               uint128_t r3, uint128_t r4)
+{
+    uint64_t c;
+
+    r1 += (uint64_t) (r0 >> 51);
+    r2 += (uint64_t) (r1 >> 51);
+    r3 += (uint64_t) (r2 >> 51);
+    r4 += (uint64_t) (r3 >> 51);
+    c = (uint64_t) (r4 >> 51);
+
+    h[0] = ((uint64_t) r0 & MASK51) + 19 * c;
+    h[1] = (uint64_t) r1 & MASK51;
+    h[2] = (uint64_t) r2 & MASK51;
+    h[3] = (uint64_t) r3 & MASK51;
+    h[4] = (uint64_t) r4 & MASK51;
+
+    h[1] += h[0] >> 51;
+    h[0] &= MASK51;
+}
+
+static inline void
+fe51_mul(fe51 h, const fe51 f, const fe51 g)
+{
+    const uint64_t g1_19 = 19 * g[1], g2_19 = 19 * g[2];
+    const uint64_t g3_19 = 19 * g[3], g4_19 = 19 * g[4];
+    uint128_t      r0, r1, r2, r3, r4;
+
+    r0 = (uint128_t) f[0] * g[0] + (uint128_t) f[1] * g4_19 +
+         (uint128_t) f[2] * g3_19 + (uint128_t) f[3] * g2_19 +
+         (uint128_t) f[4] * g1_19;
+    r1 = (uint128_t) f[0] * g[1] + (uint128_t) f[1] * g[0] +
+         (uint128_t) f[2] * g4_19 + (uint128_t) f[3] * g3_19 +
+         (uint128_t) f[4] * g2_19;
+    r2 = (uint128_t) f[0] * g[2] + (uint128_t) f[1] * g[1] +
+         (uint128_t) f[2] * g[0] + (uint128_t) f[3] * g4_19 +
+         (uint128_t) f[4] * g3_19;
+    r3 = (uint128_t) f[0] * g[3] + (uint128_t) f[1] * g[2] +
+         (uint128_t) f[2] * g[1] + (uint128_t) f[3] * g[0] +
+         (uint128_t) f[4] * g4_19;
+    r4 = (uint128_t) f[0] * g[4] + (uint128_t) f[1] * g[3] +
+         (uint128_t) f[2] * g[2] + (uint128_t) f[3] * g[1] +
+         (uint128_t) f[4] * g[0];
+
+    fe51_reduce128(h, r0, r1, r2, r3, r4);
+}
+
+static inline void
+fe51_sq(fe51 h, const fe51 f)
+{
+    const uint64_t f0_2 = 2 * f[0], f1_2 = 2 * f[1];
+    const uint64_t f3_19 = 19 * f[3], f4_19 = 19 * f[4];
+    uint128_t      r0, r1, r2, r3, r4;
+
+    r0 = (uint128_t) f[0] * f[0] + (uint128_t) (2 * f[1]) * f4_19 +
+         (uint128_t) (2 * f[2]) * f3_19;
+    r1 = (uint128_t) f0_2 * f[1] + (uint128_t) (2 * f[2]) * f4_19 +
+         (uint128_t) f[3] * f3_19;
+    r2 = (uint128_t) f0_2 * f[2] + (uint128_t) f[1] * f[1] +
+         (uint128_t) (2 * f[3]) * f4_19;
+    r3 = (uint128_t) f0_2 * f[3] + (uint128_t) f1_2 * f[2] +
+         (uint128_t) f[4] * f4_19;
+    r4 = (uint128_t) f0_2 * f[4] + (uint128_t) f1_2 * f[3] +
+         (uint128_t) f[2] * f[2];
+
+    fe51_reduce128(h, r0, r1, r2, r3, r4);
+}
+
+static inline void
+fe51_sqn(fe51 h, const fe51 f, int n)
+{
+    fe51_sq(h, f);
+    while (--n > 0) {
+        fe51_sq(h, h);
+    }
+}
+
+static inline void
+fe51_mul121665(fe51 h, const fe51 f)
+{
+    fe51_reduce128(h, (uint128_t) f[0] * 121665, (uint128_t) f[1] * 121665,
+                   (uint128_t) f[2] * 121665, (uint128_t) f[3] * 121665,
+                   (uint128_t) f[4] * 121665);
+}
+
+//! `f = g` if `b == 1`, unchanged if `b == 0`.
+static inline void
+fe51_cmov(fe51 f, const fe51 g, uint64_t b)
+{
+    const uint64_t mask = (uint64_t) 0 - b;
+    int            i;
+
+    for (i = 0; i < 5; i++) {
+        f[i] ^= mask & (f[i] ^ g[i]);
+    }
+}
+
+static inline void
+fe51_cswap(fe51 f, fe51 g, uint64_t b)
+{
+    const uint64_t mask = (uint64_t) 0 - b;
+    uint64_t       t;
+    int            i;
+
+    for (i = 0; i < 5; i++) {
+        t = mask & (f[i] ^ g[i]);
+        f[i] ^= t;
+        g[i] ^= t;
+    }
+}
+
+//! `out = z^(p-2)`, ref10 addition chain (254 squarings, 11 multiplies).
+static inline void
+fe51_invert(fe51 out, const fe51 z)
+{
+    fe51 t0, t1, t2, t3;
+
+    fe51_sq(t0, z);
+    fe51_sqn(t1, t0, 2);
+    fe51_mul(t1, z, t1);
+    fe51_mul(t0, t0, t1);
+    fe51_sq(t2, t0);
+    fe51_mul(t1, t1, t2);
+    fe51_sqn(t2, t1, 5);
+    fe51_mul(t1, t2, t1);
+    fe51_sqn(t2, t1, 10);
+    fe51_mul(t2, t2, t1);
+    fe51_sqn(t3, t2, 20);
+    fe51_mul(t2, t3, t2);
+    fe51_sqn(t2, t2, 10);
+    fe51_mul(t1, t2, t1);
+    fe51_sqn(t2, t1, 50);
+    fe51_mul(t2, t2, t1);
+    fe51_sqn(t3, t2, 100);
+    fe51_mul(t2, t3, t2);
+    fe51_sqn(t2, t2, 50);
+    fe51_mul(t1, t2, t1);
+    fe51_sqn(t1, t1, 5);
+    fe51_mul(out, t1, t0);
+}
+
+#endif
+
+#endif
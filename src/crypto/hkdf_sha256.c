@@ -0,0 +1,93 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+
+#include <errno.h>
+#include <string.h>
+
+#include "hkdf_sha256.h"
+#include "hmac_sha256.h"
+
+int
+crypto_kdf_hkdf_sha256_extract(
+    unsigned char prk[crypto_kdf_hkdf_sha256_KEYBYTES],
+    const unsigned char *salt, size_t salt_len,
+    const unsigned char *ikm, size_t ikm_len)
+{
+    static const unsigned char zero[crypto_kdf_hkdf_sha256_KEYBYTES];
+
+    if (salt == NULL) {
+        /* RFC 5869: "if not provided, it is set to a string of HashLen
+           zeros" */
+        salt = zero;
+        salt_len = sizeof zero;
+    }
+    return crypto_auth_hmacsha256(prk, ikm, ikm_len, salt, salt_len);
+}
+
+int
+crypto_kdf_hkdf_sha256_expand(
+    unsigned char *out, size_t out_len,
+    const char *ctx, size_t ctx_len,
+    const unsigned char prk[crypto_kdf_hkdf_sha256_KEYBYTES])
+{
+    crypto_auth_hmacsha256_state key;
+    crypto_auth_hmacsha256_state st;
+    unsigned char                tmp[crypto_auth_hmacsha256_BYTES];
+    size_t                       i;
+    size_t                       left;
+    unsigned char                counter = 1U;
+
+    if (out_len > crypto_kdf_hkdf_sha256_BYTES_MAX) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    /* keyed once; each block copies the state instead of re-hashing `prk` */
+    crypto_auth_hmacsha256_init(&key, prk, crypto_kdf_hkdf_sha256_KEYBYTES);
+    for (i = 0U; i < out_len; i += crypto_auth_hmacsha256_BYTES) {
+        st = key;
+        if (i != 0U) {
+            crypto_auth_hmacsha256_update(&st, tmp, sizeof tmp);
+        }
+        if (ctx_len != 0U) {
+            crypto_auth_hmacsha256_update(&st, (const unsigned char *) ctx,
+                                          ctx_len);
+        }
+        crypto_auth_hmacsha256_update(&st, &counter, 1U);
+        crypto_auth_hmacsha256_final(&st, tmp);
+        counter++;
+
+        left = out_len - i;
+        memcpy(out + i, tmp,
+               left < sizeof tmp ? left : sizeof tmp);
+    }
+
+    explicit_bzero(&key, sizeof key);
+    explicit_bzero(&st, sizeof st);
+    explicit_bzero(tmp, sizeof tmp);
+
+    return 0;
+}
@@ -0,0 +1,59 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+
+#ifndef crypto_kdf_hkdf_sha256_H
+#define crypto_kdf_hkdf_sha256_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define crypto_kdf_hkdf_sha256_KEYBYTES 32U
+#define crypto_kdf_hkdf_sha256_BYTES_MAX (255U * 32U)
+
+/* HKDF-SHA256 (RFC 5869). `extract` concentrates `ikm` into a pseudorandom
+   key `prk`; `expand` then produces any number of independent outputs from
+   `prk`, one per `ctx` (the RFC "info" string). */
+int crypto_kdf_hkdf_sha256_extract(
+    unsigned char prk[crypto_kdf_hkdf_sha256_KEYBYTES],
+    const unsigned char *salt, size_t salt_len,
+    const unsigned char *ikm, size_t ikm_len)
+            __attribute__ ((nonnull(1)));
+
+//! \return -1 if `out_len > crypto_kdf_hkdf_sha256_BYTES_MAX`, else 0.
+int crypto_kdf_hkdf_sha256_expand(
+    unsigned char *out, size_t out_len,
+    const char *ctx, size_t ctx_len,
+    const unsigned char prk[crypto_kdf_hkdf_sha256_KEYBYTES])
+            __attribute__ ((nonnull(1, 5)));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
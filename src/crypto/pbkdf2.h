@@ -0,0 +1,60 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef crypto_pbkdf2_H
+#define crypto_pbkdf2_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* PBKDF2-HMAC-SHA512 (RFC 8018). BIP-39 uses this to turn a mnemonic and
+   passphrase into a seed (2048 iterations, 64 byte output). */
+int crypto_pbkdf2_sha512(unsigned char *out, size_t outlen,
+                         const unsigned char *pass, size_t passlen,
+                         const unsigned char *salt, size_t saltlen,
+                         uint64_t iterations)
+            __attribute__ ((nonnull(1)));
+
+/* Four independent `crypto_pbkdf2_sha512` derivations, e.g. candidate
+   passphrases for one mnemonic. The iterations run in parallel 64-bit AVX2
+   lanes when supported, otherwise one lane at a time. */
+int crypto_pbkdf2_sha512_x4(unsigned char *const out[4], size_t outlen,
+                            const unsigned char *const pass[4],
+                            const size_t passlen[4],
+                            const unsigned char *const salt[4],
+                            const size_t saltlen[4], uint64_t iterations)
+            __attribute__ ((nonnull));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
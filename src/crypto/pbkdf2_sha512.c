@@ -0,0 +1,132 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <string.h>
+
+#include "hmac_sha512.h"
+#include "pbkdf2.h"
+
+static void
+store64_be(uint8_t dst[8], uint64_t w)
+{
+    int i;
+
+    for (i = 7; i >= 0; i--) {
+        dst[i] = (uint8_t) w;
+        w >>= 8;
+    }
+}
+
+/*
+ * Every iteration after the first hashes exactly one 64-byte digest, which
+ * is a single padded block for both the inner and outer hash. The blocks
+ * are built once and compressed directly from the key midstates, skipping
+ * the buffering in `crypto_hash_sha512_update` (2 compressions/iteration).
+ */
+static void
+pbkdf2_iterate(const crypto_auth_hmacsha512_state *key, uint8_t u[64],
+               uint8_t t[64], uint64_t iterations)
+{
+    uint8_t  block[crypto_hash_sha512_BLOCKBYTES];
+    uint64_t state[8];
+    uint64_t i;
+    int      j;
+
+    memset(block, 0, sizeof block);
+    block[64] = 0x80;
+    store64_be(&block[120], (crypto_hash_sha512_BLOCKBYTES + 64) * 8);
+
+    for (i = 1; i < iterations; i++) {
+        memcpy(block, u, 64);
+        memcpy(state, key->ictx.state, sizeof state);
+        crypto_hash_sha512_blocks(state, block, 1);
+        for (j = 0; j < 8; j++) {
+            store64_be(&block[j * 8], state[j]);
+        }
+
+        memcpy(state, key->octx.state, sizeof state);
+        crypto_hash_sha512_blocks(state, block, 1);
+        for (j = 0; j < 8; j++) {
+            store64_be(&u[j * 8], state[j]);
+        }
+
+        for (j = 0; j < 64; j++) {
+            t[j] ^= u[j];
+        }
+    }
+
+    explicit_bzero(block, sizeof block);
+    explicit_bzero(state, sizeof state);
+}
+
+int
+crypto_pbkdf2_sha512(unsigned char *out, size_t outlen,
+                     const unsigned char *pass, size_t passlen,
+                     const unsigned char *salt, size_t saltlen,
+                     uint64_t iterations)
+{
+    crypto_auth_hmacsha512_state key;
+    crypto_auth_hmacsha512_state hctx;
+    uint8_t                      ivec[4];
+    uint8_t                      u[64];
+    uint8_t                      t[64];
+    size_t                       i;
+    size_t                       clen;
+
+    if (iterations == 0) {
+        return -1;
+    }
+
+    crypto_auth_hmacsha512_init(&key, pass, passlen);
+    for (i = 0; i * 64 < outlen; i++) {
+        ivec[0] = (uint8_t) ((i + 1) >> 24);
+        ivec[1] = (uint8_t) ((i + 1) >> 16);
+        ivec[2] = (uint8_t) ((i + 1) >> 8);
+        ivec[3] = (uint8_t) (i + 1);
+
+        memcpy(&hctx, &key, sizeof hctx);
+        crypto_auth_hmacsha512_update(&hctx, salt, saltlen);
+        crypto_auth_hmacsha512_update(&hctx, ivec, 4);
+        crypto_auth_hmacsha512_final(&hctx, u);
+        memcpy(t, u, 64);
+
+        pbkdf2_iterate(&key, u, t, iterations);
+
+        clen = outlen - i * 64;
+        if (clen > 64) {
+            clen = 64;
+        }
+        memcpy(&out[i * 64], t, clen);
+    }
+
+    explicit_bzero(&key, sizeof key);
+    explicit_bzero(&hctx, sizeof hctx);
+    explicit_bzero(u, sizeof u);
+    explicit_bzero(t, sizeof t);
+
+    return 0;
+}
@@ -0,0 +1,241 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/* Multi-lane PBKDF2-HMAC-SHA512: four derivations with independent
+   passwords and salts run in lockstep, one derivation per 64-bit AVX2 lane.
+   After the first HMAC every iteration hashes a single 64-byte digest, so
+   the message schedule padding is constant and the chaining values never
+   leave registers between iterations. */
+
+#include <string.h>
+
+#include "hmac_sha512.h"
+#include "pbkdf2.h"
+#include "runtime.h"
+#include "sha512_impl.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+# include <immintrin.h>
+
+static void
+store64_be(uint8_t dst[8], uint64_t w)
+{
+    int i;
+
+    for (i = 7; i >= 0; i--) {
+        dst[i] = (uint8_t) w;
+        w >>= 8;
+    }
+}
+
+static uint64_t
+load64_be(const uint8_t src[8])
+{
+    uint64_t w;
+    memcpy(&w, src, sizeof w);
+    return __builtin_bswap64(w); /* configure requires little endian */
+}
+
+/* AVX2 has no 64-bit rotate; AVX-512 `vprolq` would save one op per ROTR */
+# define V_ADD(a, b)  _mm256_add_epi64((a), (b))
+# define V_XOR(a, b)  _mm256_xor_si256((a), (b))
+# define V_AND(a, b)  _mm256_and_si256((a), (b))
+# define V_OR(a, b)   _mm256_or_si256((a), (b))
+# define V_ROTR(x, n) V_OR(_mm256_srli_epi64((x), (n)), _mm256_slli_epi64((x), 64 - (n)))
+# define V_SHR(x, n)  _mm256_srli_epi64((x), (n))
+# define V_SET1(a)    _mm256_set1_epi64x((long long) (a))
+
+# define V_S0(x) V_XOR(V_XOR(V_ROTR(x, 28), V_ROTR(x, 34)), V_ROTR(x, 39))
+# define V_S1(x) V_XOR(V_XOR(V_ROTR(x, 14), V_ROTR(x, 18)), V_ROTR(x, 41))
+# define V_s0(x) V_XOR(V_XOR(V_ROTR(x, 1), V_ROTR(x, 8)), V_SHR(x, 7))
+# define V_s1(x) V_XOR(V_XOR(V_ROTR(x, 19), V_ROTR(x, 61)), V_SHR(x, 6))
+# define V_CH(x, y, z) V_XOR(V_AND(x, V_XOR(y, z)), z)
+# define V_MAJ(x, y, z) V_OR(V_AND(x, V_OR(y, z)), V_AND(y, z))
+
+/* Same register rotation as `MB_RND` in sha256_mb.c */
+# define V_RND(a, b, c, d, e, f, g, h, i)                                     \
+    do {                                                                      \
+        if ((i) >= 16) {                                                      \
+            W[(i) & 15] = V_ADD(                                              \
+                V_ADD(V_s1(W[((i) - 2) & 15]), W[((i) - 7) & 15]),            \
+                V_ADD(V_s0(W[((i) - 15) & 15]), W[(i) & 15]));                \
+        }                                                                     \
+        h = V_ADD(V_ADD(h, V_S1(e)),                                          \
+                  V_ADD(V_CH(e, f, g),                                        \
+                        V_ADD(V_SET1(crypto_hash_sha512_K[i]), W[(i) & 15]))); \
+        d = V_ADD(d, h);                                                      \
+        h = V_ADD(h, V_ADD(V_S0(a), V_MAJ(a, b, c)));                         \
+    } while (0)
+
+/* `out` = compression of the single padded block holding digest words
+   `in[0..7]`, starting from chaining value `iv`. */
+__attribute__((target("avx2")))
+static inline void
+compress_digest_x4(__m256i out[8], const __m256i iv[8], const __m256i in[8])
+{
+    __m256i W[16];
+    __m256i a, b, c, d, e, f, g, h;
+    int     i;
+
+    for (i = 0; i < 8; i++) {
+        W[i] = in[i];
+    }
+    W[8] = V_SET1(0x8000000000000000ULL);
+    for (i = 9; i < 15; i++) {
+        W[i] = _mm256_setzero_si256();
+    }
+    W[15] = V_SET1((128 + 64) * 8);
+
+    a = iv[0]; b = iv[1]; c = iv[2]; d = iv[3];
+    e = iv[4]; f = iv[5]; g = iv[6]; h = iv[7];
+    for (i = 0; i < 80; i += 8) {
+        V_RND(a, b, c, d, e, f, g, h, i + 0);
+        V_RND(h, a, b, c, d, e, f, g, i + 1);
+        V_RND(g, h, a, b, c, d, e, f, i + 2);
+        V_RND(f, g, h, a, b, c, d, e, i + 3);
+        V_RND(e, f, g, h, a, b, c, d, i + 4);
+        V_RND(d, e, f, g, h, a, b, c, i + 5);
+        V_RND(c, d, e, f, g, h, a, b, i + 6);
+        V_RND(b, c, d, e, f, g, h, a, i + 7);
+    }
+    out[0] = V_ADD(iv[0], a); out[1] = V_ADD(iv[1], b);
+    out[2] = V_ADD(iv[2], c); out[3] = V_ADD(iv[3], d);
+    out[4] = V_ADD(iv[4], e); out[5] = V_ADD(iv[5], f);
+    out[6] = V_ADD(iv[6], g); out[7] = V_ADD(iv[7], h);
+}
+
+__attribute__((target("avx2")))
+void
+crypto_pbkdf2_sha512_x4_avx2(unsigned char *const out[4], size_t outlen,
+                             const unsigned char *const pass[4],
+                             const size_t passlen[4],
+                             const unsigned char *const salt[4],
+                             const size_t saltlen[4], uint64_t iterations)
+{
+    crypto_auth_hmacsha512_state key[4];
+    crypto_auth_hmacsha512_state hctx;
+    __m256i                      istate[8], ostate[8], u[8], t[8], inner[8];
+    uint64_t                     lanes[4];
+    uint8_t                      ivec[4];
+    uint8_t                      block[64];
+    uint64_t                     it;
+    size_t                       i, clen;
+    int                          j, l;
+
+    for (l = 0; l < 4; l++) {
+        crypto_auth_hmacsha512_init(&key[l], pass[l], passlen[l]);
+    }
+    for (j = 0; j < 8; j++) {
+        istate[j] = _mm256_set_epi64x(
+            (long long) key[3].ictx.state[j], (long long) key[2].ictx.state[j],
+            (long long) key[1].ictx.state[j], (long long) key[0].ictx.state[j]);
+        ostate[j] = _mm256_set_epi64x(
+            (long long) key[3].octx.state[j], (long long) key[2].octx.state[j],
+            (long long) key[1].octx.state[j], (long long) key[0].octx.state[j]);
+    }
+
+    for (i = 0; i * 64 < outlen; i++) {
+        ivec[0] = (uint8_t) ((i + 1) >> 24);
+        ivec[1] = (uint8_t) ((i + 1) >> 16);
+        ivec[2] = (uint8_t) ((i + 1) >> 8);
+        ivec[3] = (uint8_t) (i + 1);
+
+        /* U1 = HMAC(salt || INT(i)) per lane; salts may differ in length */
+        for (j = 0; j < 8; j++) {
+            u[j] = _mm256_setzero_si256();
+        }
+        for (l = 0; l < 4; l++) {
+            memcpy(&hctx, &key[l], sizeof hctx);
+            crypto_auth_hmacsha512_update(&hctx, salt[l], saltlen[l]);
+            crypto_auth_hmacsha512_update(&hctx, ivec, 4);
+            crypto_auth_hmacsha512_final(&hctx, block);
+            for (j = 0; j < 8; j++) {
+                _mm256_storeu_si256((__m256i *) (void *) lanes, u[j]);
+                lanes[l] = load64_be(block + 8 * j);
+                u[j] = _mm256_loadu_si256((const __m256i *) (const void *) lanes);
+            }
+        }
+        for (j = 0; j < 8; j++) {
+            t[j] = u[j];
+        }
+
+        for (it = 1; it < iterations; it++) {
+            compress_digest_x4(inner, istate, u);
+            compress_digest_x4(u, ostate, inner);
+            for (j = 0; j < 8; j++) {
+                t[j] = V_XOR(t[j], u[j]);
+            }
+        }
+
+        clen = outlen - i * 64;
+        if (clen > 64) {
+            clen = 64;
+        }
+        for (l = 0; l < 4; l++) {
+            for (j = 0; j < 8; j++) {
+                _mm256_storeu_si256((__m256i *) (void *) lanes, t[j]);
+                store64_be(block + 8 * j, lanes[l]);
+            }
+            memcpy(&out[l][i * 64], block, clen);
+        }
+    }
+
+    explicit_bzero(key, sizeof key);
+    explicit_bzero(&hctx, sizeof hctx);
+    explicit_bzero(lanes, sizeof lanes);
+    explicit_bzero(block, sizeof block);
+    explicit_bzero(u, sizeof u);
+    explicit_bzero(t, sizeof t);
+    explicit_bzero(inner, sizeof inner);
+}
+#endif
+
+int
+crypto_pbkdf2_sha512_x4(unsigned char *const out[4], size_t outlen,
+                        const unsigned char *const pass[4],
+                        const size_t passlen[4],
+                        const unsigned char *const salt[4],
+                        const size_t saltlen[4], uint64_t iterations)
+{
+    int l;
+
+    if (iterations == 0) {
+        return -1;
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    if (crypto_runtime_has_avx2()) {
+        crypto_pbkdf2_sha512_x4_avx2(out, outlen, pass, passlen, salt, saltlen,
+                                     iterations);
+        return 0;
+    }
+#endif
+    for (l = 0; l < 4; l++) {
+        crypto_pbkdf2_sha512(out[l], outlen, pass[l], passlen[l], salt[l],
+                             saltlen[l], iterations);
+    }
+    return 0;
+}
@@ -0,0 +1,117 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "runtime.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+# include <cpuid.h>
+#elif defined(__aarch64__) && defined(__linux__)
+# include <sys/auxv.h>
+# include <asm/hwcap.h>
+#endif
+
+#define CPU_FEATURE_SHANI       0x1
+#define CPU_FEATURE_AVX2        0x2
+#define CPU_FEATURE_ARMV8_SHA2  0x4
+#define CPU_FEATURE_INITIALIZED 0x80000000
+
+#if defined(__x86_64__) || defined(__i386__)
+static unsigned
+detect_features(void)
+{
+    unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+    unsigned features = 0;
+    unsigned ecx1;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return 0;
+    }
+    ecx1 = ecx;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        return 0;
+    }
+
+    /* SHA (leaf 7 ebx:29) kernel also uses SSSE3 (leaf 1 ecx:9) and SSE4.1
+       (leaf 1 ecx:19) instructions. */
+    if ((ebx & (1U << 29)) && (ecx1 & (1U << 9)) && (ecx1 & (1U << 19))) {
+        features |= CPU_FEATURE_SHANI;
+    }
+
+    /* AVX2 (leaf 7 ebx:5) also requires OS saving of YMM registers */
+    if ((ebx & (1U << 5)) && (ecx1 & (1U << 27))) {
+        unsigned xcr0_lo, xcr0_hi;
+        __asm__ __volatile__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+        if ((xcr0_lo & 0x6) == 0x6) {
+            features |= CPU_FEATURE_AVX2;
+        }
+    }
+    return features;
+}
+#elif defined(__aarch64__) && defined(__linux__)
+static unsigned
+detect_features(void)
+{
+    return (getauxval(AT_HWCAP) & HWCAP_SHA2) ? CPU_FEATURE_ARMV8_SHA2 : 0;
+}
+#else
+static unsigned
+detect_features(void)
+{
+    return 0;
+}
+#endif
+
+static unsigned
+get_features(void)
+{
+    /* Detection is idempotent; racing threads store the same value. */
+    static unsigned features = 0;
+    unsigned current = __atomic_load_n(&features, __ATOMIC_RELAXED);
+    if (!current) {
+        current = detect_features() | CPU_FEATURE_INITIALIZED;
+        __atomic_store_n(&features, current, __ATOMIC_RELAXED);
+    }
+    return current;
+}
+
+int
+crypto_runtime_has_shani(void)
+{
+    return (get_features() & CPU_FEATURE_SHANI) != 0;
+}
+
+int
+crypto_runtime_has_avx2(void)
+{
+    return (get_features() & CPU_FEATURE_AVX2) != 0;
+}
+
+int
+crypto_runtime_has_armv8_sha2(void)
+{
+    return (get_features() & CPU_FEATURE_ARMV8_SHA2) != 0;
+}
@@ -52,6 +52,27 @@ int crypto_hash_sha256_final(crypto_hash_sha256_state *state,
                              unsigned char *out)
             __attribute__ ((nonnull));
 
+/*
+ * Multi-buffer hashing: `out[i]` is the SHA-256 of `inlen[i]` bytes at
+ * `in[i]`. Messages are hashed in parallel SIMD lanes when the CPU supports
+ * it (x4 with SSE2, x8 with AVX2), otherwise one at a time. Best suited for
+ * many short messages, such as URIs and ECDH secrets.
+ */
+int crypto_hash_sha256_x4(unsigned char out[4][crypto_hash_sha256_BYTES],
+                          const unsigned char *const in[4],
+                          const unsigned long long inlen[4])
+            __attribute__ ((nonnull));
+
+int crypto_hash_sha256_x8(unsigned char out[8][crypto_hash_sha256_BYTES],
+                          const unsigned char *const in[8],
+                          const unsigned long long inlen[8])
+            __attribute__ ((nonnull));
+
+//! Hash `count` messages, using `_x8` and `_x4` for as many as possible.
+int crypto_hash_sha256_many(unsigned char (*out)[crypto_hash_sha256_BYTES],
+                            const unsigned char *const *in,
+                            const unsigned long long *inlen, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
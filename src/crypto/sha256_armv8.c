@@ -0,0 +1,99 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/* SHA-256 block compression with the ARMv8 cryptography extensions. The
+   function is compiled for the extension only; `sha256_cp.c` calls it after
+   `crypto_runtime_has_armv8_sha2()`. */
+
+#if defined(__aarch64__)
+
+#include <arm_neon.h>
+
+#include "sha256_impl.h"
+
+/* Four rounds with W[t..t+3] in MSG. */
+#define ARMV8_ROUNDS(K, MSG)                                                \
+    do {                                                                    \
+        const uint32x4_t t_ = vaddq_u32((MSG), vld1q_u32(K));               \
+        const uint32x4_t s_ = state0;                                       \
+        state0 = vsha256hq_u32(state0, state1, t_);                         \
+        state1 = vsha256h2q_u32(state1, s_, t_);                            \
+    } while (0)
+
+/* M0 = W[t..t+3] computed from M0 = W[t-16..], M1 = W[t-12..],
+   M2 = W[t-8..], M3 = W[t-4..] */
+#define ARMV8_SCHEDULE(M0, M1, M2, M3)                                      \
+    M0 = vsha256su1q_u32(vsha256su0q_u32(M0, M1), M2, M3)
+
+#define ARMV8_LOAD(SRC) \
+    vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(SRC)))
+
+__attribute__((target("+crypto")))
+void
+crypto_hash_sha256_blocks_armv8(uint32_t state[8], const uint8_t *in,
+                                size_t blocks)
+{
+    const uint32_t *const K = crypto_hash_sha256_K;
+    uint32x4_t state0 = vld1q_u32(&state[0]);
+    uint32x4_t state1 = vld1q_u32(&state[4]);
+    uint32x4_t abcd, efgh;
+    uint32x4_t m0, m1, m2, m3;
+    int        i;
+
+    for (; blocks; --blocks, in += 64) {
+        abcd = state0;
+        efgh = state1;
+
+        m0 = ARMV8_LOAD(in);
+        m1 = ARMV8_LOAD(in + 16);
+        m2 = ARMV8_LOAD(in + 32);
+        m3 = ARMV8_LOAD(in + 48);
+
+        for (i = 0; i < 48; i += 16) {
+            ARMV8_ROUNDS(K + i, m0);
+            ARMV8_SCHEDULE(m0, m1, m2, m3);
+            ARMV8_ROUNDS(K + i + 4, m1);
+            ARMV8_SCHEDULE(m1, m2, m3, m0);
+            ARMV8_ROUNDS(K + i + 8, m2);
+            ARMV8_SCHEDULE(m2, m3, m0, m1);
+            ARMV8_ROUNDS(K + i + 12, m3);
+            ARMV8_SCHEDULE(m3, m0, m1, m2);
+        }
+        ARMV8_ROUNDS(K + 48, m0);
+        ARMV8_ROUNDS(K + 52, m1);
+        ARMV8_ROUNDS(K + 56, m2);
+        ARMV8_ROUNDS(K + 60, m3);
+
+        state0 = vaddq_u32(state0, abcd);
+        state1 = vaddq_u32(state1, efgh);
+    }
+
+    vst1q_u32(&state[0], state0);
+    vst1q_u32(&state[4], state1);
+}
+
+#endif
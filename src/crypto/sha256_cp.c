@@ -52,7 +52,9 @@
 
 #include <sys/types.h>
 
+#include "runtime.h"
 #include "sha256.h"
+#include "sha256_impl.h"
 //#include "crypto_hash_sha256.h"
 //#include "private/common.h"
 //#include "utils.h"
@@ -147,7 +149,8 @@ be32dec_vect(uint32_t *dst, const unsigned char *src, size_t len)
     }
 }
 
-static const uint32_t Krnd[64] = {
+#define Krnd crypto_hash_sha256_K
+const uint32_t crypto_hash_sha256_K[64] = {
     0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
     0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
     0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
@@ -234,6 +237,67 @@ SHA256_Transform(uint32_t state[8], const uint8_t block[64], uint32_t W[64],
     }
 }
 
+void
+crypto_hash_sha256_blocks_cp(uint32_t state[8], const uint8_t *in,
+                             size_t blocks)
+{
+    uint32_t tmp32[64 + 8];
+
+    for (; blocks; --blocks, in += 64) {
+        SHA256_Transform(state, in, &tmp32[0], &tmp32[64]);
+    }
+}
+
+static int
+always_available(void)
+{
+    return 1;
+}
+
+static const crypto_hash_sha256_implementation implementations[] = {
+    { "cp", crypto_hash_sha256_blocks_cp, always_available },
+#if defined(__x86_64__) || defined(__i386__)
+    { "shani", crypto_hash_sha256_blocks_shani, crypto_runtime_has_shani },
+#endif
+#if defined(__aarch64__)
+    { "armv8", crypto_hash_sha256_blocks_armv8, crypto_runtime_has_armv8_sha2 },
+#endif
+};
+
+const crypto_hash_sha256_implementation *
+crypto_hash_sha256_implementations(size_t *count)
+{
+    *count = sizeof implementations / sizeof implementations[0];
+    return implementations;
+}
+
+const crypto_hash_sha256_implementation *
+crypto_hash_sha256_current_implementation(void)
+{
+    static const crypto_hash_sha256_implementation *current = NULL;
+    const crypto_hash_sha256_implementation *best =
+        __atomic_load_n(&current, __ATOMIC_RELAXED);
+    size_t i;
+
+    if (best == NULL) {
+        /* last available kernel in the list is the fastest */
+        best = &implementations[0];
+        for (i = 1; i < sizeof implementations / sizeof implementations[0]; i++) {
+            if (implementations[i].available()) {
+                best = &implementations[i];
+            }
+        }
+        __atomic_store_n(&current, best, __ATOMIC_RELAXED);
+    }
+    return best;
+}
+
+static void
+SHA256_Blocks(uint32_t state[8], const uint8_t *in, size_t blocks)
+{
+    crypto_hash_sha256_current_implementation()->blocks(state, in, blocks);
+}
+
 static const uint8_t PAD[64] = { 0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
                                  0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
                                  0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -241,7 +305,7 @@ static const uint8_t PAD[64] = { 0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
                                  0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
 
 static void
-SHA256_Pad(crypto_hash_sha256_state *state, uint32_t tmp32[64 + 8])
+SHA256_Pad(crypto_hash_sha256_state *state)
 {
     unsigned int r;
     unsigned int i;
@@ -256,11 +320,11 @@ SHA256_Pad(crypto_hash_sha256_state *state, uint32_t tmp32[64 + 8])
         for (i = 0; i < 64 - r; i++) {
             state->buf[r + i] = PAD[i];
         }
-        SHA256_Transform(state->state, state->buf, &tmp32[0], &tmp32[64]);
+        SHA256_Blocks(state->state, state->buf, 1);
         memset(&state->buf[0], 0, 56);
     }
     STORE64_BE(&state->buf[56], state->count);
-    SHA256_Transform(state->state, state->buf, &tmp32[0], &tmp32[64]);
+    SHA256_Blocks(state->state, state->buf, 1);
 }
 
 int
@@ -281,7 +345,6 @@ int
 crypto_hash_sha256_update(crypto_hash_sha256_state *state,
                           const unsigned char *in, unsigned long long inlen)
 {
-    uint32_t           tmp32[64 + 8];
     unsigned long long i;
     unsigned long long r;
 
@@ -301,20 +364,18 @@ crypto_hash_sha256_update(crypto_hash_sha256_state *state,
     for (i = 0; i < 64 - r; i++) {
         state->buf[r + i] = in[i];
     }
-    SHA256_Transform(state->state, state->buf, &tmp32[0], &tmp32[64]);
+    SHA256_Blocks(state->state, state->buf, 1);
     in += 64 - r;
     inlen -= 64 - r;
 
-    while (inlen >= 64) {
-        SHA256_Transform(state->state, in, &tmp32[0], &tmp32[64]);
-        in += 64;
-        inlen -= 64;
+    if (inlen >= 64) {
+        SHA256_Blocks(state->state, in, (size_t) (inlen / 64));
+        in += inlen & ~(unsigned long long) 63;
     }
     inlen &= 63;
     for (i = 0; i < inlen; i++) {
         state->buf[i] = in[i];
     }
-  //  sodium_memzero((void *) tmp32, sizeof tmp32);
 
     return 0;
 }
@@ -322,11 +383,8 @@ crypto_hash_sha256_update(crypto_hash_sha256_state *state,
 int
 crypto_hash_sha256_final(crypto_hash_sha256_state *state, unsigned char *out)
 {
-    uint32_t tmp32[64 + 8];
-
-    SHA256_Pad(state, tmp32);
+    SHA256_Pad(state);
     be32enc_vect(out, state->state, 32);
-//    sodium_memzero((void *) tmp32, sizeof tmp32);
   //  sodium_memzero((void *) state, sizeof *state);
 
     return 0;
@@ -0,0 +1,89 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef crypto_hash_sha256_impl_H
+#define crypto_hash_sha256_impl_H
+
+/* Internal interface between the SHA-256 front-end (`sha256_cp.c`) and the
+   block compression kernels. Not for use outside of `src/crypto` and the
+   benchmarks. */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Round constants shared by all kernels.
+extern const uint32_t crypto_hash_sha256_K[64];
+
+//! Compress `blocks` consecutive 64-byte blocks from `in` into `state`.
+typedef void (*crypto_hash_sha256_blocks_fn)(uint32_t state[8],
+                                             const uint8_t *in, size_t blocks);
+
+typedef struct crypto_hash_sha256_implementation {
+    const char                  *name;
+    crypto_hash_sha256_blocks_fn blocks;
+    int                        (*available)(void);
+} crypto_hash_sha256_implementation;
+
+void crypto_hash_sha256_blocks_cp(uint32_t state[8], const uint8_t *in,
+                                  size_t blocks);
+#if defined(__x86_64__) || defined(__i386__)
+void crypto_hash_sha256_blocks_shani(uint32_t state[8], const uint8_t *in,
+                                     size_t blocks);
+#endif
+#if defined(__aarch64__)
+void crypto_hash_sha256_blocks_armv8(uint32_t state[8], const uint8_t *in,
+                                     size_t blocks);
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+//! Multi-buffer kernels without dispatch. \pre CPU support for the ISA.
+void crypto_hash_sha256_x4_sse2(unsigned char out[4][32],
+                                const unsigned char *const in[4],
+                                const unsigned long long inlen[4]);
+void crypto_hash_sha256_x8_avx2(unsigned char out[8][32],
+                                const unsigned char *const in[8],
+                                const unsigned long long inlen[8]);
+#endif
+
+/*! \return List of kernels compiled into this binary, portable kernel first.
+    Check `available()` before calling a kernel. */
+const crypto_hash_sha256_implementation *
+crypto_hash_sha256_implementations(size_t *count);
+
+//! \return Kernel selected for the running CPU.
+const crypto_hash_sha256_implementation *
+crypto_hash_sha256_current_implementation(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
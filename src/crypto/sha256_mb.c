@@ -0,0 +1,381 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/* Multi-buffer SHA-256: independent messages are hashed in parallel, one
+   message per 32-bit SIMD lane. Each lane is padded separately and the
+   blocks are compressed in lockstep, so messages of different lengths can be
+   mixed. This is intended for many short messages (one or two blocks); a
+   single long message is faster with `crypto_hash_sha256`. */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "runtime.h"
+#include "sha256.h"
+#include "sha256_impl.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+# include <immintrin.h>
+
+#define MB_MAX_LANES 8
+
+typedef void (*mb_compress_fn)(uint32_t *state, const uint8_t *const *blocks);
+
+typedef struct mb_lane {
+    size_t  full;       /* blocks read directly from input */
+    size_t  blocks;     /* total blocks including padding */
+    uint8_t tail[128];  /* final partial block + padding */
+} mb_lane;
+
+static const uint32_t mb_initial_state[8] = { 0x6a09e667, 0xbb67ae85,
+                                              0x3c6ef372, 0xa54ff53a,
+                                              0x510e527f, 0x9b05688c,
+                                              0x1f83d9ab, 0x5be0cd19 };
+
+static inline uint32_t
+mb_load32_be(const uint8_t *src)
+{
+    uint32_t w;
+    memcpy(&w, src, sizeof w);
+    return __builtin_bswap32(w); /* configure requires little endian */
+}
+
+/* Round function shared by the SSE2 and AVX2 kernels. The `MB_*` primitives
+   are defined per instruction set below; each one is a 32-bit lane-wise
+   operation. */
+# define MB_ROTR(x, n) MB_OR(MB_SRLI((x), (n)), MB_SLLI((x), 32 - (n)))
+# define MB_S0(x) MB_XOR(MB_XOR(MB_ROTR(x, 2), MB_ROTR(x, 13)), MB_ROTR(x, 22))
+# define MB_S1(x) MB_XOR(MB_XOR(MB_ROTR(x, 6), MB_ROTR(x, 11)), MB_ROTR(x, 25))
+# define MB_s0(x) MB_XOR(MB_XOR(MB_ROTR(x, 7), MB_ROTR(x, 18)), MB_SRLI(x, 3))
+# define MB_s1(x) MB_XOR(MB_XOR(MB_ROTR(x, 17), MB_ROTR(x, 19)), MB_SRLI(x, 10))
+# define MB_CH(x, y, z) MB_XOR(MB_AND(x, MB_XOR(y, z)), z)
+# define MB_MAJ(x, y, z) MB_OR(MB_AND(x, MB_OR(y, z)), MB_AND(y, z))
+
+/* Same register rotation as `RNDr` in sha256_cp.c; `i` is the round index */
+# define MB_RND(a, b, c, d, e, f, g, h, i)                                    \
+    do {                                                                      \
+        if ((i) >= 16) {                                                      \
+            W[(i) & 15] = MB_ADD(                                             \
+                MB_ADD(MB_s1(W[((i) - 2) & 15]), W[((i) - 7) & 15]),          \
+                MB_ADD(MB_s0(W[((i) - 15) & 15]), W[(i) & 15]));              \
+        }                                                                     \
+        h = MB_ADD(MB_ADD(h, MB_S1(e)),                                       \
+                   MB_ADD(MB_CH(e, f, g),                                     \
+                          MB_ADD(MB_SET1(crypto_hash_sha256_K[i]),            \
+                                 W[(i) & 15])));                              \
+        d = MB_ADD(d, h);                                                     \
+        h = MB_ADD(h, MB_ADD(MB_S0(a), MB_MAJ(a, b, c)));                     \
+    } while (0)
+
+# define MB_COMPRESS_BODY(VEC, LANES)                                         \
+    VEC W[16];                                                                \
+    VEC a, b, c, d, e, f, g, h;                                               \
+    int i;                                                                    \
+                                                                              \
+    MB_LOAD_W(W, blocks);                                                     \
+    a = MB_LOAD(&state[0 * LANES]);                                           \
+    b = MB_LOAD(&state[1 * LANES]);                                           \
+    c = MB_LOAD(&state[2 * LANES]);                                           \
+    d = MB_LOAD(&state[3 * LANES]);                                           \
+    e = MB_LOAD(&state[4 * LANES]);                                           \
+    f = MB_LOAD(&state[5 * LANES]);                                           \
+    g = MB_LOAD(&state[6 * LANES]);                                           \
+    h = MB_LOAD(&state[7 * LANES]);                                           \
+    for (i = 0; i < 64; i += 8) {                                             \
+        MB_RND(a, b, c, d, e, f, g, h, i + 0);                                \
+        MB_RND(h, a, b, c, d, e, f, g, i + 1);                                \
+        MB_RND(g, h, a, b, c, d, e, f, i + 2);                                \
+        MB_RND(f, g, h, a, b, c, d, e, i + 3);                                \
+        MB_RND(e, f, g, h, a, b, c, d, i + 4);                                \
+        MB_RND(d, e, f, g, h, a, b, c, i + 5);                                \
+        MB_RND(c, d, e, f, g, h, a, b, i + 6);                                \
+        MB_RND(b, c, d, e, f, g, h, a, i + 7);                                \
+    }                                                                         \
+    MB_STORE(&state[0 * LANES], MB_ADD(MB_LOAD(&state[0 * LANES]), a));      \
+    MB_STORE(&state[1 * LANES], MB_ADD(MB_LOAD(&state[1 * LANES]), b));      \
+    MB_STORE(&state[2 * LANES], MB_ADD(MB_LOAD(&state[2 * LANES]), c));      \
+    MB_STORE(&state[3 * LANES], MB_ADD(MB_LOAD(&state[3 * LANES]), d));      \
+    MB_STORE(&state[4 * LANES], MB_ADD(MB_LOAD(&state[4 * LANES]), e));      \
+    MB_STORE(&state[5 * LANES], MB_ADD(MB_LOAD(&state[5 * LANES]), f));      \
+    MB_STORE(&state[6 * LANES], MB_ADD(MB_LOAD(&state[6 * LANES]), g));      \
+    MB_STORE(&state[7 * LANES], MB_ADD(MB_LOAD(&state[7 * LANES]), h))
+
+# define MB_ADD(a, b)   _mm_add_epi32((a), (b))
+# define MB_XOR(a, b)   _mm_xor_si128((a), (b))
+# define MB_AND(a, b)   _mm_and_si128((a), (b))
+# define MB_OR(a, b)    _mm_or_si128((a), (b))
+# define MB_SRLI(a, n)  _mm_srli_epi32((a), (n))
+# define MB_SLLI(a, n)  _mm_slli_epi32((a), (n))
+# define MB_SET1(a)     _mm_set1_epi32((int) (a))
+# define MB_LOAD(p)     _mm_loadu_si128((const __m128i *) (const void *) (p))
+# define MB_STORE(p, v) _mm_storeu_si128((__m128i *) (void *) (p), (v))
+# define MB_LOAD_W(W, b)                                                      \
+    for (i = 0; i < 16; i++) {                                                \
+        W[i] = _mm_set_epi32((int) mb_load32_be((b)[3] + 4 * i),              \
+                             (int) mb_load32_be((b)[2] + 4 * i),              \
+                             (int) mb_load32_be((b)[1] + 4 * i),              \
+                             (int) mb_load32_be((b)[0] + 4 * i));             \
+    }
+
+__attribute__((target("sse2")))
+static void
+mb_compress_sse2(uint32_t *state, const uint8_t *const *blocks)
+{
+    MB_COMPRESS_BODY(__m128i, 4);
+}
+
+# undef MB_ADD
+# undef MB_XOR
+# undef MB_AND
+# undef MB_OR
+# undef MB_SRLI
+# undef MB_SLLI
+# undef MB_SET1
+# undef MB_LOAD
+# undef MB_STORE
+# undef MB_LOAD_W
+
+# define MB_ADD(a, b)   _mm256_add_epi32((a), (b))
+# define MB_XOR(a, b)   _mm256_xor_si256((a), (b))
+# define MB_AND(a, b)   _mm256_and_si256((a), (b))
+# define MB_OR(a, b)    _mm256_or_si256((a), (b))
+# define MB_SRLI(a, n)  _mm256_srli_epi32((a), (n))
+# define MB_SLLI(a, n)  _mm256_slli_epi32((a), (n))
+# define MB_SET1(a)     _mm256_set1_epi32((int) (a))
+# define MB_LOAD(p)     _mm256_loadu_si256((const __m256i *) (const void *) (p))
+# define MB_STORE(p, v) _mm256_storeu_si256((__m256i *) (void *) (p), (v))
+# define MB_LOAD_W(W, b)                                                      \
+    do {                                                                      \
+        mb_load_w_avx2(&W[0], b, 0);                                          \
+        mb_load_w_avx2(&W[8], b, 32);                                         \
+    } while (0)
+
+/* W[0..7] = byte-swapped 32-bit words at `offset` in each of the 8 blocks,
+   transposed so each vector holds one word index across all lanes. */
+__attribute__((target("avx2")))
+static inline void
+mb_load_w_avx2(__m256i W[8], const uint8_t *const *blocks, size_t offset)
+{
+    const __m256i byteswap = _mm256_set_epi8(
+        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    __m256i r[8], t[8];
+    int     i;
+
+    for (i = 0; i < 8; i++) {
+        r[i] = _mm256_shuffle_epi8(
+            _mm256_loadu_si256((const __m256i *) (const void *) (blocks[i] + offset)),
+            byteswap);
+    }
+
+    /* 8x8 transpose of 32-bit elements */
+    t[0] = _mm256_unpacklo_epi32(r[0], r[1]);
+    t[1] = _mm256_unpackhi_epi32(r[0], r[1]);
+    t[2] = _mm256_unpacklo_epi32(r[2], r[3]);
+    t[3] = _mm256_unpackhi_epi32(r[2], r[3]);
+    t[4] = _mm256_unpacklo_epi32(r[4], r[5]);
+    t[5] = _mm256_unpackhi_epi32(r[4], r[5]);
+    t[6] = _mm256_unpacklo_epi32(r[6], r[7]);
+    t[7] = _mm256_unpackhi_epi32(r[6], r[7]);
+
+    r[0] = _mm256_unpacklo_epi64(t[0], t[2]);
+    r[1] = _mm256_unpackhi_epi64(t[0], t[2]);
+    r[2] = _mm256_unpacklo_epi64(t[1], t[3]);
+    r[3] = _mm256_unpackhi_epi64(t[1], t[3]);
+    r[4] = _mm256_unpacklo_epi64(t[4], t[6]);
+    r[5] = _mm256_unpackhi_epi64(t[4], t[6]);
+    r[6] = _mm256_unpacklo_epi64(t[5], t[7]);
+    r[7] = _mm256_unpackhi_epi64(t[5], t[7]);
+
+    W[0] = _mm256_permute2x128_si256(r[0], r[4], 0x20);
+    W[1] = _mm256_permute2x128_si256(r[1], r[5], 0x20);
+    W[2] = _mm256_permute2x128_si256(r[2], r[6], 0x20);
+    W[3] = _mm256_permute2x128_si256(r[3], r[7], 0x20);
+    W[4] = _mm256_permute2x128_si256(r[0], r[4], 0x31);
+    W[5] = _mm256_permute2x128_si256(r[1], r[5], 0x31);
+    W[6] = _mm256_permute2x128_si256(r[2], r[6], 0x31);
+    W[7] = _mm256_permute2x128_si256(r[3], r[7], 0x31);
+}
+
+__attribute__((target("avx2")))
+static void
+mb_compress_avx2(uint32_t *state, const uint8_t *const *blocks)
+{
+    MB_COMPRESS_BODY(__m256i, 8);
+}
+
+static void
+mb_init_lane(mb_lane *lane, const unsigned char *in, unsigned long long inlen)
+{
+    const size_t rem = (size_t) (inlen & 63);
+    const uint64_t bits = (uint64_t) inlen << 3;
+    size_t tail_blocks = rem < 56 ? 1 : 2;
+    size_t i;
+
+    lane->full = (size_t) (inlen / 64);
+    lane->blocks = lane->full + tail_blocks;
+
+    memset(lane->tail, 0, sizeof lane->tail);
+    if (rem) {
+        memcpy(lane->tail, in + lane->full * 64, rem);
+    }
+    lane->tail[rem] = 0x80;
+    for (i = 0; i < 8; i++) {
+        lane->tail[tail_blocks * 64 - 1 - i] = (uint8_t) (bits >> (i * 8));
+    }
+}
+
+static void
+mb_hash(size_t lanes, mb_compress_fn compress,
+        unsigned char (*out)[crypto_hash_sha256_BYTES],
+        const unsigned char *const *in, const unsigned long long *inlen)
+{
+    mb_lane        lane[MB_MAX_LANES];
+    uint32_t       state[8 * MB_MAX_LANES];
+    const uint8_t *blocks[MB_MAX_LANES];
+    size_t         max_blocks = 0;
+    size_t         b, i, j;
+
+    for (j = 0; j < lanes; j++) {
+        mb_init_lane(&lane[j], in[j], inlen[j]);
+        if (max_blocks < lane[j].blocks) {
+            max_blocks = lane[j].blocks;
+        }
+        for (i = 0; i < 8; i++) {
+            state[i * lanes + j] = mb_initial_state[i];
+        }
+    }
+
+    for (b = 0; b < max_blocks; b++) {
+        for (j = 0; j < lanes; j++) {
+            if (b < lane[j].full) {
+                blocks[j] = in[j] + b * 64;
+            } else if (b < lane[j].blocks) {
+                blocks[j] = lane[j].tail + (b - lane[j].full) * 64;
+            } else {
+                blocks[j] = lane[j].tail; /* finished; result ignored */
+            }
+        }
+        compress(state, blocks);
+
+        for (j = 0; j < lanes; j++) {
+            if (b + 1 == lane[j].blocks) {
+                for (i = 0; i < 8; i++) {
+                    const uint32_t w = state[i * lanes + j];
+                    out[j][i * 4 + 0] = (uint8_t) (w >> 24);
+                    out[j][i * 4 + 1] = (uint8_t) (w >> 16);
+                    out[j][i * 4 + 2] = (uint8_t) (w >> 8);
+                    out[j][i * 4 + 3] = (uint8_t) w;
+                }
+            }
+        }
+    }
+}
+
+#endif /* x86 */
+
+static void
+serial_hash(size_t count, unsigned char (*out)[crypto_hash_sha256_BYTES],
+            const unsigned char *const *in, const unsigned long long *inlen)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++) {
+        crypto_hash_sha256(out[i], in[i], inlen[i]);
+    }
+}
+
+int
+crypto_hash_sha256_x4(unsigned char out[4][crypto_hash_sha256_BYTES],
+                      const unsigned char *const in[4],
+                      const unsigned long long inlen[4])
+{
+#if defined(__x86_64__) || defined(__i386__)
+    /* SHA-NI hashes one message faster than four SSE2 lanes hash four */
+    if (!crypto_runtime_has_shani()) {
+        mb_hash(4, mb_compress_sse2, out, in, inlen);
+        return 0;
+    }
+#endif
+    serial_hash(4, out, in, inlen);
+    return 0;
+}
+
+int
+crypto_hash_sha256_x8(unsigned char out[8][crypto_hash_sha256_BYTES],
+                      const unsigned char *const in[8],
+                      const unsigned long long inlen[8])
+{
+#if defined(__x86_64__) || defined(__i386__)
+    /* SHA-NI one message at a time and AVX2 x8 are roughly equal, prefer the
+       simpler path */
+    if (!crypto_runtime_has_shani() && crypto_runtime_has_avx2()) {
+        mb_hash(8, mb_compress_avx2, out, in, inlen);
+        return 0;
+    }
+#endif
+    crypto_hash_sha256_x4(out, in, inlen);
+    crypto_hash_sha256_x4(out + 4, in + 4, inlen + 4);
+    return 0;
+}
+
+int
+crypto_hash_sha256_many(unsigned char (*out)[crypto_hash_sha256_BYTES],
+                        const unsigned char *const *in,
+                        const unsigned long long *inlen, size_t count)
+{
+    for (; 8 <= count; count -= 8, out += 8, in += 8, inlen += 8) {
+        crypto_hash_sha256_x8(out, in, inlen);
+    }
+    if (4 <= count) {
+        crypto_hash_sha256_x4(out, in, inlen);
+        count -= 4;
+        out += 4;
+        in += 4;
+        inlen += 4;
+    }
+    serial_hash(count, out, in, inlen);
+    return 0;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+void
+crypto_hash_sha256_x4_sse2(unsigned char out[4][crypto_hash_sha256_BYTES],
+                           const unsigned char *const in[4],
+                           const unsigned long long inlen[4])
+{
+    mb_hash(4, mb_compress_sse2, out, in, inlen);
+}
+
+void
+crypto_hash_sha256_x8_avx2(unsigned char out[8][crypto_hash_sha256_BYTES],
+                           const unsigned char *const in[8],
+                           const unsigned long long inlen[8])
+{
+    mb_hash(8, mb_compress_avx2, out, in, inlen);
+}
+#endif
@@ -0,0 +1,116 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/* SHA-256 block compression with the x86 SHA extensions. Message schedule
+   and round structure follow the Intel SHA extensions white paper. The
+   function is compiled for the extension only; `sha256_cp.c` calls it after
+   `crypto_runtime_has_shani()`. */
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+
+#include "sha256_impl.h"
+
+#define SHANI_ROUNDS(K, MSG)                                                \
+    do {                                                                    \
+        __m128i t_ = _mm_add_epi32(                                         \
+            (MSG), _mm_loadu_si128((const __m128i *) (const void *) (K)));  \
+        state1 = _mm_sha256rnds2_epu32(state1, state0, t_);                 \
+        t_     = _mm_shuffle_epi32(t_, 0x0E);                               \
+        state0 = _mm_sha256rnds2_epu32(state0, state1, t_);                 \
+    } while (0)
+
+/* M0 = W[t..t+3] computed from M0 = W[t-16..], M1 = W[t-12..],
+   M2 = W[t-8..], M3 = W[t-4..] */
+#define SHANI_SCHEDULE(M0, M1, M2, M3)                                      \
+    M0 = _mm_sha256msg2_epu32(                                              \
+        _mm_add_epi32(_mm_sha256msg1_epu32(M0, M1),                         \
+                      _mm_alignr_epi8(M3, M2, 4)),                          \
+        M3)
+
+#define SHANI_LOAD(SRC)                                                     \
+    _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (const void *) (SRC)), \
+                     byteswap)
+
+__attribute__((target("sha,sse4.1")))
+void
+crypto_hash_sha256_blocks_shani(uint32_t state[8], const uint8_t *in,
+                                size_t blocks)
+{
+    const uint32_t *const K = crypto_hash_sha256_K;
+    const __m128i byteswap =
+        _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i state0, state1, tmp, abef, cdgh;
+    __m128i m0, m1, m2, m3;
+    int     i;
+
+    /* state is stored as ABCD EFGH; rounds operate on ABEF and CDGH */
+    tmp    = _mm_loadu_si128((const __m128i *) (const void *) &state[0]);
+    state1 = _mm_loadu_si128((const __m128i *) (const void *) &state[4]);
+    tmp    = _mm_shuffle_epi32(tmp, 0xB1);          /* CDAB */
+    state1 = _mm_shuffle_epi32(state1, 0x1B);       /* EFGH */
+    state0 = _mm_alignr_epi8(tmp, state1, 8);       /* ABEF */
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);    /* CDGH */
+
+    for (; blocks; --blocks, in += 64) {
+        abef = state0;
+        cdgh = state1;
+
+        m0 = SHANI_LOAD(in);
+        SHANI_ROUNDS(K, m0);
+        m1 = SHANI_LOAD(in + 16);
+        SHANI_ROUNDS(K + 4, m1);
+        m2 = SHANI_LOAD(in + 32);
+        SHANI_ROUNDS(K + 8, m2);
+        m3 = SHANI_LOAD(in + 48);
+        SHANI_ROUNDS(K + 12, m3);
+
+        for (i = 16; i < 64; i += 16) {
+            SHANI_SCHEDULE(m0, m1, m2, m3);
+            SHANI_ROUNDS(K + i, m0);
+            SHANI_SCHEDULE(m1, m2, m3, m0);
+            SHANI_ROUNDS(K + i + 4, m1);
+            SHANI_SCHEDULE(m2, m3, m0, m1);
+            SHANI_ROUNDS(K + i + 8, m2);
+            SHANI_SCHEDULE(m3, m0, m1, m2);
+            SHANI_ROUNDS(K + i + 12, m3);
+        }
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    tmp    = _mm_shuffle_epi32(state0, 0x1B);       /* FEBA */
+    state1 = _mm_shuffle_epi32(state1, 0xB1);       /* DCHG */
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);    /* DCBA */
+    state1 = _mm_alignr_epi8(state1, tmp, 8);       /* ABEF */
+    _mm_storeu_si128((__m128i *) (void *) &state[0], state0);
+    _mm_storeu_si128((__m128i *) (void *) &state[4], state1);
+}
+
+#endif
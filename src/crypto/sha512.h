@@ -0,0 +1,49 @@
+#ifndef crypto_hash_sha512_H
+#define crypto_hash_sha512_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+
+#ifdef __cplusplus
+# ifdef __GNUC__
+#  pragma GCC diagnostic ignored "-Wlong-long"
+# endif
+extern "C" {
+#endif
+
+typedef struct crypto_hash_sha512_state {
+    uint64_t state[8];
+    uint64_t count[2];
+    uint8_t  buf[128];
+} crypto_hash_sha512_state;
+
+#define crypto_hash_sha512_BYTES 64U
+#define crypto_hash_sha512_BLOCKBYTES 128U
+
+int crypto_hash_sha512(unsigned char *out, const unsigned char *in,
+                       unsigned long long inlen) __attribute__ ((nonnull(1)));
+
+int crypto_hash_sha512_init(crypto_hash_sha512_state *state)
+            __attribute__ ((nonnull));
+
+int crypto_hash_sha512_update(crypto_hash_sha512_state *state,
+                              const unsigned char *in,
+                              unsigned long long inlen)
+            __attribute__ ((nonnull(1)));
+
+int crypto_hash_sha512_final(crypto_hash_sha512_state *state,
+                             unsigned char *out)
+            __attribute__ ((nonnull));
+
+/* Compress `blocks` 128-byte blocks into `state` without padding. For
+   callers that manage their own block buffers (HMAC midstates, PBKDF2). */
+void crypto_hash_sha512_blocks(uint64_t state[8], const uint8_t *in,
+                               size_t blocks) __attribute__ ((nonnull));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
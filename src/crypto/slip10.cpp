@@ -0,0 +1,317 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "slip10.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <sys/mman.h>
+#include <system_error>
+
+#include "crypto/hmac_sha512.h"
+#include "crypto/x25519.h"
+#include "error.hpp"
+
+namespace slip10
+{
+  namespace
+  {
+    node from_hmac(const std::uint8_t (&hash)[crypto_auth_hmacsha512_BYTES]) noexcept
+    {
+      node out{};
+      std::memcpy(out.key.data(), hash, out.key.size());
+      std::memcpy(out.chain_code.data(), hash + out.key.size(), out.chain_code.size());
+      return out;
+    }
+
+    //! \return HMAC-SHA512 message for hardened child `index` of `parent`.
+    std::array<std::uint8_t, 1 + 32 + 4> child_message(const node& parent, const std::uint32_t index) noexcept
+    {
+      // 0x00 || key || ser32(index)
+      std::array<std::uint8_t, 1 + 32 + 4> data{{0}};
+      std::memcpy(data.data() + 1, parent.key.data(), parent.key.size());
+      data[33] = std::uint8_t(index >> 24);
+      data[34] = std::uint8_t(index >> 16);
+      data[35] = std::uint8_t(index >> 8);
+      data[36] = std::uint8_t(index);
+      return data;
+    }
+  }
+
+  seed::~seed() noexcept
+  {
+    explicit_bzero(bytes.data(), bytes.size());
+  }
+
+  node::~node() noexcept
+  {
+    explicit_bzero(key.data(), key.size());
+    explicit_bzero(chain_code.data(), chain_code.size());
+  }
+
+  node curve25519_master(const seed& source) noexcept
+  {
+    static constexpr const char curve[] = "curve25519 seed";
+
+    std::uint8_t hash[crypto_auth_hmacsha512_BYTES];
+    crypto_auth_hmacsha512(
+      hash,
+      source.bytes.data(),
+      source.bytes.size(),
+      reinterpret_cast<const unsigned char*>(curve),
+      sizeof(curve) - 1
+    );
+
+    node out = from_hmac(hash);
+    explicit_bzero(hash, sizeof(hash));
+    return out;
+  }
+
+  expect<node> derive(const node& parent, const std::uint32_t index)
+  {
+    if (!(index & hardened))
+      return {common_error::invalid_argument};
+
+    std::array<std::uint8_t, 1 + 32 + 4> data = child_message(parent, index);
+    std::uint8_t hash[crypto_auth_hmacsha512_BYTES];
+    crypto_auth_hmacsha512(hash, data.data(), data.size(), parent.chain_code.data(), parent.chain_code.size());
+
+    node out = from_hmac(hash);
+    explicit_bzero(hash, sizeof(hash));
+    explicit_bzero(data.data(), data.size());
+    return out;
+  }
+
+  expect<node> derive(const node& root, const span<const std::uint32_t> path)
+  {
+    node current = root;
+    for (const std::uint32_t index : path)
+    {
+      expect<node> next = derive(current, index);
+      if (!next)
+        return next.error();
+      current = *next;
+    }
+    return current;
+  }
+
+  std::array<std::uint8_t, 33> curve25519_public_key(const node& source) noexcept
+  {
+    std::array<std::uint8_t, 33> out{{0x01}};
+    crypto_scalarmult_curve25519_base(out.data() + 1, source.key.data());
+    return out;
+  }
+
+  struct cache::entry
+  {
+    node value;
+    crypto_auth_hmacsha512_state hmac; //!< Keyed by `value.chain_code`
+    std::array<std::uint32_t, max_depth> path;
+    std::size_t depth;
+    bool has_hmac;     //!< `hmac` is computed on first use as a parent
+    entry* newer;
+    entry* older;
+
+    void wipe() noexcept
+    {
+      explicit_bzero(this, sizeof(*this));
+    }
+
+    crypto_auth_hmacsha512_state& get_hmac() noexcept
+    {
+      if (!has_hmac)
+      {
+        crypto_auth_hmacsha512_init(&hmac, value.chain_code.data(), value.chain_code.size());
+        has_hmac = true;
+      }
+      return hmac;
+    }
+
+    bool is_prefix_of(const span<const std::uint32_t> full) const noexcept
+    {
+      return depth <= full.size() && std::equal(path.begin(), path.begin() + depth, full.begin());
+    }
+  };
+
+  std::size_t cache::mapping_size(const std::size_t capacity) noexcept
+  {
+    return sizeof(entry) * (capacity + 1);
+  }
+
+  cache::cache(entry* const entries, const std::size_t capacity) noexcept
+    : entries_(entries), capacity_(capacity), size_(0), newest_(nullptr), oldest_(nullptr)
+  {}
+
+  expect<cache> cache::make(const node& root, const std::size_t capacity)
+  {
+    MACER_PRECOND(capacity < (std::size_t(-1) / sizeof(entry)) - 1);
+
+    const std::size_t size = mapping_size(capacity);
+    void* const memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+      return {std::error_code{errno, std::system_category()}};
+    if (mlock(memory, size) != 0)
+    {
+      const std::error_code error{errno, std::system_category()};
+      munmap(memory, size);
+      return error;
+    }
+#ifdef MADV_DONTDUMP
+    madvise(memory, size, MADV_DONTDUMP);
+#endif
+
+    entry* const entries = static_cast<entry*>(memory);
+    for (std::size_t i = 0; i <= capacity; ++i)
+      new (entries + i) entry{};
+    entries[0].value = root;
+    return cache{entries, capacity};
+  }
+
+  cache::cache(cache&& source) noexcept
+    : entries_(source.entries_),
+      capacity_(source.capacity_),
+      size_(source.size_),
+      newest_(source.newest_),
+      oldest_(source.oldest_)
+  {
+    source.entries_ = nullptr;
+    source.capacity_ = 0;
+    source.size_ = 0;
+    source.newest_ = nullptr;
+    source.oldest_ = nullptr;
+  }
+
+  cache::~cache() noexcept
+  {
+    if (entries_)
+    {
+      const std::size_t size = mapping_size(capacity_);
+      explicit_bzero(entries_, size);
+      munlock(entries_, size);
+      munmap(entries_, size);
+    }
+  }
+
+  cache::entry* cache::find(const span<const std::uint32_t> path) noexcept
+  {
+    entry* best = entries_;
+    for (entry* current = newest_; current; current = current->older)
+    {
+      if (best->depth < current->depth && current->is_prefix_of(path))
+        best = current;
+    }
+    return best;
+  }
+
+  void cache::touch(entry* const item) noexcept
+  {
+    if (item == newest_)
+      return;
+
+    // unlink, unless `item` is a fresh slot
+    if (item->newer)
+      item->newer->older = item->older;
+    if (item->older)
+      item->older->newer = item->newer;
+    if (item == oldest_)
+      oldest_ = item->newer;
+
+    item->newer = nullptr;
+    item->older = newest_;
+    if (newest_)
+      newest_->newer = item;
+    newest_ = item;
+    if (!oldest_)
+      oldest_ = item;
+  }
+
+  cache::entry* cache::acquire() noexcept
+  {
+    if (size_ < capacity_)
+      return entries_ + 1 + size_++;
+
+    entry* const victim = oldest_;
+    oldest_ = victim->newer;
+    if (oldest_)
+      oldest_->older = nullptr;
+    else
+      newest_ = nullptr;
+    victim->wipe();
+    return victim;
+  }
+
+  expect<node> cache::derive(const span<const std::uint32_t> path)
+  {
+    entry* current = find(path);
+    if (current != entries_)
+      touch(current);
+
+    node parent = current->value;
+    for (std::size_t depth = current->depth; depth < path.size(); ++depth)
+    {
+      const std::uint32_t index = path[depth];
+      if (!(index & hardened))
+        return {common_error::invalid_argument};
+
+      // copy of the midstate skips hashing the padded chain code again
+      crypto_auth_hmacsha512_state state = current ? current->get_hmac() : crypto_auth_hmacsha512_state{};
+      if (!current)
+        crypto_auth_hmacsha512_init(&state, parent.chain_code.data(), parent.chain_code.size());
+
+      std::array<std::uint8_t, 1 + 32 + 4> data = child_message(parent, index);
+      std::uint8_t hash[crypto_auth_hmacsha512_BYTES];
+      crypto_auth_hmacsha512_update(&state, data.data(), data.size());
+      crypto_auth_hmacsha512_final(&state, hash);
+      parent = from_hmac(hash);
+      explicit_bzero(hash, sizeof(hash));
+      explicit_bzero(data.data(), data.size());
+      explicit_bzero(&state, sizeof(state));
+
+      current = nullptr;
+      if (depth < max_depth && capacity_)
+      {
+        current = acquire();
+        current->value = parent;
+        std::copy(path.begin(), path.begin() + depth + 1, current->path.begin());
+        current->depth = depth + 1;
+        touch(current);
+      }
+    }
+    return parent;
+  }
+
+  void cache::clear() noexcept
+  {
+    for (std::size_t i = 1; i <= size_; ++i)
+      entries_[i].wipe();
+    size_ = 0;
+    newest_ = nullptr;
+    oldest_ = nullptr;
+  }
+}
@@ -0,0 +1,135 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "expect.hpp"
+#include "span.hpp"
+
+//! SLIP-10 hierarchical derivation for curve25519 (hardened children only).
+namespace slip10
+{
+  constexpr const std::size_t seed_size = 64;
+  constexpr const std::uint32_t hardened = 0x80000000;
+
+  //! BIP-39 seed; wiped on destruction.
+  struct seed
+  {
+    std::array<std::uint8_t, seed_size> bytes;
+
+    seed() noexcept : bytes() {}
+    seed(const seed&) = default;
+    ~seed() noexcept;
+    seed& operator=(const seed&) = default;
+  };
+
+  //! Private key and chain code; wiped on destruction.
+  struct node
+  {
+    std::array<std::uint8_t, 32> key;
+    std::array<std::uint8_t, 32> chain_code;
+
+    node() noexcept : key(), chain_code() {}
+    node(const node&) = default;
+    ~node() noexcept;
+    node& operator=(const node&) = default;
+  };
+
+  //! \return Master node from HMAC-SHA512("curve25519 seed", `source`).
+  node curve25519_master(const seed& source) noexcept;
+
+  /*! \return Child `index` of `parent`; curve25519 only supports hardened
+        derivation, so `index` must have the `hardened` bit set. */
+  expect<node> derive(const node& parent, std::uint32_t index);
+
+  //! \return Node at `path` relative to `root`.
+  expect<node> derive(const node& root, span<const std::uint32_t> path);
+
+  /*! \return Public key for `source` as the Trezor firmware reports it:
+        0x01 followed by the x25519 public key. */
+  std::array<std::uint8_t, 33> curve25519_public_key(const node& source) noexcept;
+
+  /*! LRU cache of nodes derived below one root, for callers deriving many
+      paths with a shared prefix (every macer identity is below `m/17'`).
+      Each entry also keeps the HMAC-SHA512 midstate keyed by its chain code,
+      so deriving a child of a cached node hashes only the message blocks.
+
+      All entries (and the root) live in one `mlock`ed mapping that is
+      excluded from core dumps, and are wiped when evicted or destroyed.
+      Not thread-safe. */
+  class cache
+  {
+    struct entry;
+
+    entry* entries_;        //!< `[0]` is the root; the rest are LRU slots
+    std::size_t capacity_;  //!< LRU slots, excluding the root
+    std::size_t size_;      //!< Used LRU slots
+    entry* newest_;
+    entry* oldest_;
+
+    cache(entry* entries, std::size_t capacity) noexcept;
+
+    //! \return Bytes mapped for the root and `capacity` slots.
+    static std::size_t mapping_size(std::size_t capacity) noexcept;
+
+    //! \return Cached entry with the longest prefix of `path`, or root.
+    entry* find(span<const std::uint32_t> path) noexcept;
+
+    //! Mark `item` as most recently used.
+    void touch(entry* item) noexcept;
+
+    //! \return A free slot, evicting (and wiping) the oldest when full.
+    entry* acquire() noexcept;
+
+  public:
+    //! Maximum depth of a cached node (paths can be longer).
+    static constexpr const std::size_t max_depth = 8;
+
+    /*! \return Cache holding up to `capacity` nodes below `root`, or the
+          `mmap`/`mlock` error when locked memory is unavailable. */
+    static expect<cache> make(const node& root, std::size_t capacity);
+
+    cache(cache&& source) noexcept;
+    cache(const cache&) = delete;
+    ~cache() noexcept;
+    cache& operator=(const cache&) = delete;
+    cache& operator=(cache&&) = delete;
+
+    //! \return Number of cached nodes, excluding the root.
+    std::size_t size() const noexcept { return size_; }
+
+    //! \return Same as `slip10::derive(root, path)`, caching each node.
+    expect<node> derive(span<const std::uint32_t> path);
+
+    //! Wipe and drop every cached node; the root is kept.
+    void clear() noexcept;
+  };
+}
@@ -0,0 +1,155 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/* Kernel selection and the public X25519 interface. The portable ladder is
+   kept as a reference for the benchmark; 64-bit targets use the radix 2^51
+   kernel, and batches of four use AVX2 lanes when available. Public keys
+   (base point 9) use the fixed-base comb instead of a ladder. */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "runtime.h"
+#include "x25519.h"
+#include "x25519_impl.h"
+
+static int
+always_available(void)
+{
+    return 1;
+}
+
+static const crypto_scalarmult_curve25519_implementation implementations[] = {
+    { "ref", crypto_scalarmult_curve25519_ref, always_available },
+#if defined(__SIZEOF_INT128__)
+    { "radix51", crypto_scalarmult_curve25519_51, always_available },
+#endif
+};
+
+const crypto_scalarmult_curve25519_implementation *
+crypto_scalarmult_curve25519_implementations(size_t *count)
+{
+    *count = sizeof implementations / sizeof implementations[0];
+    return implementations;
+}
+
+const crypto_scalarmult_curve25519_implementation *
+crypto_scalarmult_curve25519_current_implementation(void)
+{
+    static const crypto_scalarmult_curve25519_implementation *current = NULL;
+    const crypto_scalarmult_curve25519_implementation *best =
+        __atomic_load_n(&current, __ATOMIC_RELAXED);
+    size_t i;
+
+    if (best == NULL) {
+        /* last available kernel in the list is the fastest */
+        best = &implementations[0];
+        for (i = 1; i < sizeof implementations / sizeof implementations[0]; i++) {
+            if (implementations[i].available()) {
+                best = &implementations[i];
+            }
+        }
+        __atomic_store_n(&current, best, __ATOMIC_RELAXED);
+    }
+    return best;
+}
+
+//! \return 1 if `q` is all zeros, without branching on its contents.
+static int
+is_zero(const unsigned char q[32])
+{
+    unsigned char d = 0;
+    int           i;
+
+    for (i = 0; i < 32; i++) {
+        d |= q[i];
+    }
+    return 1 & ((d - 1) >> 8);
+}
+
+int
+crypto_scalarmult_curve25519(unsigned char *q, const unsigned char *n,
+                             const unsigned char *p)
+{
+    crypto_scalarmult_curve25519_current_implementation()->scalarmult(q, n, p);
+    return -is_zero(q);
+}
+
+int
+crypto_scalarmult_curve25519_base(unsigned char *q, const unsigned char *n)
+{
+    return crypto_scalarmult_curve25519_base_many((unsigned char (*)[32]) q, &n, 1);
+}
+
+int
+crypto_scalarmult_curve25519_base_many(unsigned char (*q)[32],
+                                       const unsigned char *const *n,
+                                       size_t count)
+{
+    size_t i;
+    int    zero = 0;
+
+#if defined(__SIZEOF_INT128__)
+    crypto_scalarmult_curve25519_base_batch(q, n, count);
+#else
+    static const unsigned char basepoint[32] = { 9 };
+
+    for (i = 0; i < count; i++) {
+        crypto_scalarmult_curve25519_ref(q[i], n[i], basepoint);
+    }
+#endif
+    for (i = 0; i < count; i++) {
+        zero |= is_zero(q[i]);
+    }
+    return -zero;
+}
+
+int
+crypto_scalarmult_curve25519_x4(unsigned char q[4][32],
+                                const unsigned char *const n[4],
+                                const unsigned char *const p[4])
+{
+    int i, zero = 0;
+
+#if defined(__x86_64__)
+    if (crypto_runtime_has_avx2()) {
+        crypto_scalarmult_curve25519_x4_avx2(q, n, p);
+    } else
+#endif
+    {
+        const crypto_scalarmult_curve25519_fn scalarmult =
+            crypto_scalarmult_curve25519_current_implementation()->scalarmult;
+
+        for (i = 0; i < 4; i++) {
+            scalarmult(q[i], n[i], p[i]);
+        }
+    }
+    for (i = 0; i < 4; i++) {
+        zero |= is_zero(q[i]);
+    }
+    return -zero;
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/* X25519 Montgomery ladder over the radix 2^51 field in `fe25519_51.h`.
+   Every step is branch-free on secret data; the ladder swap is a masked
+   exchange. Requires a compiler with `__int128` (all 64-bit GCC/Clang
+   targets). */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "fe25519_51.h"
+#include "x25519_impl.h"
+
+#if defined(__SIZEOF_INT128__)
+
+void
+crypto_scalarmult_curve25519_51(unsigned char q[32], const unsigned char n[32],
+                                const unsigned char p[32])
+{
+    unsigned char k[32];
+    fe51          x1, x2, z2, x3, z3, a, b, aa, bb, e, c, d;
+    uint64_t      swap = 0, bit;
+    int           t;
+
+    memcpy(k, n, 32);
+    k[0] &= 248;
+    k[31] &= 127;
+    k[31] |= 64;
+
+    fe51_frombytes(x1, p);
+    memset(x2, 0, sizeof x2);
+    memset(z2, 0, sizeof z2);
+    x2[0] = 1;
+    memcpy(x3, x1, sizeof x3);
+    memset(z3, 0, sizeof z3);
+    z3[0] = 1;
+
+    for (t = 254; t >= 0; t--) {
+        bit = (k[t >> 3] >> (t & 7)) & 1;
+        swap ^= bit;
+        fe51_cswap(x2, x3, swap);
+        fe51_cswap(z2, z3, swap);
+        swap = bit;
+
+        fe51_add(a, x2, z2);
+        fe51_sub(b, x2, z2);
+        fe51_add(c, x3, z3);
+        fe51_sub(d, x3, z3);
+        fe51_sq(aa, a);
+        fe51_sq(bb, b);
+        fe51_mul(d, d, a);       /* DA */
+        fe51_mul(c, c, b);       /* CB */
+        fe51_sub(e, aa, bb);
+        fe51_add(a, d, c);
+        fe51_sub(b, d, c);
+        fe51_sq(x3, a);
+        fe51_sq(b, b);
+        fe51_mul(z3, x1, b);
+        fe51_mul(x2, aa, bb);
+        fe51_mul121665(a, e);
+        fe51_add(a, a, aa);
+        fe51_mul(z2, e, a);
+    }
+    fe51_cswap(x2, x3, swap);
+    fe51_cswap(z2, z3, swap);
+
+    fe51_invert(z2, z2);
+    fe51_mul(x2, x2, z2);
+    fe51_tobytes(q, x2);
+
+    explicit_bzero(k, sizeof k);
+    explicit_bzero(x2, sizeof x2);
+    explicit_bzero(z2, sizeof z2);
+    explicit_bzero(x3, sizeof x3);
+    explicit_bzero(z3, sizeof z3);
+}
+
+#endif
@@ -0,0 +1,430 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/* Four independent X25519 ladders, one per 64-bit AVX2 lane. Field elements
+   use ten limbs of alternating 26/25 bits (radix 2^25.5) so each limb product
+   fits `vpmuludq`. Lanes never interact and the swap masks are computed
+   without branches, so every lane runs in constant time. */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "x25519_impl.h"
+
+#if defined(__x86_64__)
+
+#include <immintrin.h>
+
+#define X25519_AVX2 __attribute__((target("avx2")))
+
+#define MASK25 ((((uint64_t) 1) << 25) - 1)
+#define MASK26 ((((uint64_t) 1) << 26) - 1)
+
+//! Limb `i` of four field elements; lane `l` belongs to ladder `l`.
+typedef struct fe4 {
+    __m256i v[10];
+} fe4;
+
+static unsigned
+limb_bits(int i)
+{
+    return (i & 1) ? 25 : 26;
+}
+
+static uint64_t
+bits_at(const uint64_t w[4], unsigned offset, unsigned count)
+{
+    const unsigned shift = offset & 63;
+    uint64_t       v = w[offset >> 6] >> shift;
+
+    if (shift + count > 64) {
+        v |= w[(offset >> 6) + 1] << (64 - shift);
+    }
+    return v & ((((uint64_t) 1) << count) - 1);
+}
+
+static X25519_AVX2 void
+fe4_frombytes(fe4 *h, const unsigned char *const s[4])
+{
+    uint64_t limbs[4][10];
+    uint64_t w[4];
+    unsigned offset;
+    int      i, l;
+
+    for (l = 0; l < 4; l++) {
+        memcpy(w, s[l], sizeof w); /* configure requires little endian */
+        offset = 0;
+        for (i = 0; i < 10; i++) {
+            limbs[l][i] = bits_at(w, offset, limb_bits(i)); /* drops bit 255 */
+            offset += limb_bits(i);
+        }
+    }
+    for (i = 0; i < 10; i++) {
+        h->v[i] = _mm256_set_epi64x((long long) limbs[3][i], (long long) limbs[2][i],
+                                    (long long) limbs[1][i], (long long) limbs[0][i]);
+    }
+}
+
+//! Fully reduced little-endian encoding of a carried element.
+static void
+fe10_tobytes(unsigned char s[32], const uint64_t f[10])
+{
+    uint64_t h[10], q, w[4] = { 0, 0, 0, 0 };
+    unsigned offset = 0, shift;
+    int      i;
+
+    memcpy(h, f, sizeof h);
+    for (i = 0; i < 9; i++) {
+        h[i + 1] += h[i] >> limb_bits(i);
+        h[i] &= (i & 1) ? MASK25 : MASK26;
+    }
+    h[0] += 19 * (h[9] >> 25);
+    h[9] &= MASK25;
+    h[1] += h[0] >> 26;
+    h[0] &= MASK26;
+
+    /* h < 2p; subtract p iff h + 19 >= 2^255 */
+    q = (h[0] + 19) >> 26;
+    for (i = 1; i < 10; i++) {
+        q = (h[i] + q) >> limb_bits(i);
+    }
+    h[0] += 19 * q;
+    for (i = 0; i < 9; i++) {
+        h[i + 1] += h[i] >> limb_bits(i);
+        h[i] &= (i & 1) ? MASK25 : MASK26;
+    }
+    h[9] &= MASK25;
+
+    for (i = 0; i < 10; i++) {
+        shift = offset & 63;
+        w[offset >> 6] |= h[i] << shift;
+        if (shift + limb_bits(i) > 64) {
+            w[(offset >> 6) + 1] |= h[i] >> (64 - shift);
+        }
+        offset += limb_bits(i);
+    }
+    memcpy(s, w, sizeof w);
+    explicit_bzero(h, sizeof h);
+    explicit_bzero(w, sizeof w);
+}
+
+static X25519_AVX2 void
+fe4_tobytes(unsigned char s[4][32], const fe4 *f)
+{
+    uint64_t limbs[10][4];
+    uint64_t lane[10];
+    int      i, l;
+
+    for (i = 0; i < 10; i++) {
+        _mm256_storeu_si256((__m256i *) limbs[i], f->v[i]);
+    }
+    for (l = 0; l < 4; l++) {
+        for (i = 0; i < 10; i++) {
+            lane[i] = limbs[i][l];
+        }
+        fe10_tobytes(s[l], lane);
+    }
+    explicit_bzero(limbs, sizeof limbs);
+    explicit_bzero(lane, sizeof lane);
+}
+
+static X25519_AVX2 void
+fe4_copy(fe4 *h, const fe4 *f)
+{
+    memcpy(h, f, sizeof *h);
+}
+
+static X25519_AVX2 void
+fe4_add(fe4 *h, const fe4 *f, const fe4 *g)
+{
+    int i;
+
+    for (i = 0; i < 10; i++) {
+        h->v[i] = _mm256_add_epi64(f->v[i], g->v[i]);
+    }
+}
+
+//! `h = f - g + 2p`, so limbs stay positive for carried `g`.
+static X25519_AVX2 void
+fe4_sub(fe4 *h, const fe4 *f, const fe4 *g)
+{
+    const __m256i p2_0 = _mm256_set1_epi64x(0x7ffffda);
+    const __m256i p2_even = _mm256_set1_epi64x(0x7fffffe);
+    const __m256i p2_odd = _mm256_set1_epi64x(0x3fffffe);
+    int           i;
+
+    h->v[0] = _mm256_sub_epi64(_mm256_add_epi64(f->v[0], p2_0), g->v[0]);
+    for (i = 1; i < 10; i++) {
+        h->v[i] = _mm256_sub_epi64(
+            _mm256_add_epi64(f->v[i], (i & 1) ? p2_odd : p2_even), g->v[i]);
+    }
+}
+
+/*! Reduce 64-bit column sums into `h`; limbs 1 and 5 may exceed 25 bits by a
+    few units of 2^12. The two carry chains are interleaved for instruction
+    level parallelism. */
+static X25519_AVX2 void
+fe4_carry(fe4 *h, __m256i r[10])
+{
+    const __m256i m25 = _mm256_set1_epi64x(MASK25);
+    const __m256i m26 = _mm256_set1_epi64x(MASK26);
+    __m256i       c;
+
+#define CARRY(i)                                                        \
+    do {                                                                \
+        c = _mm256_srli_epi64(r[i], limb_bits(i));                      \
+        r[i] = _mm256_and_si256(r[i], (i & 1) ? m25 : m26);             \
+        r[i + 1] = _mm256_add_epi64(r[i + 1], c);                       \
+    } while (0)
+
+    CARRY(0); CARRY(4);
+    CARRY(1); CARRY(5);
+    CARRY(2); CARRY(6);
+    CARRY(3); CARRY(7);
+    CARRY(4); CARRY(8);
+#undef CARRY
+
+    c = _mm256_srli_epi64(r[9], 25);
+    r[9] = _mm256_and_si256(r[9], m25);
+    /* 19 * c = c + 2c + 16c; c may exceed 32 bits here */
+    r[0] = _mm256_add_epi64(r[0], c);
+    r[0] = _mm256_add_epi64(r[0], _mm256_slli_epi64(c, 1));
+    r[0] = _mm256_add_epi64(r[0], _mm256_slli_epi64(c, 4));
+
+    c = _mm256_srli_epi64(r[0], 26);
+    r[0] = _mm256_and_si256(r[0], m26);
+    r[1] = _mm256_add_epi64(r[1], c);
+
+    memcpy(h->v, r, sizeof h->v);
+}
+
+/* Schoolbook product, 100 `vpmuludq`. Column `k` sums `f[i] * g[k - i]`,
+   wrapping indices below zero with a factor of 19 (2^255 = 19), and doubling
+   odd*odd products (both limbs are 25 bits, their weights sum to one more
+   bit than the column). Inputs must be carried or the result of one add/sub
+   of carried elements, keeping every product operand below 2^32. */
+static X25519_AVX2 void
+fe4_mul(fe4 *h, const fe4 *f, const fe4 *g)
+{
+    const __m256i nineteen = _mm256_set1_epi64x(19);
+    __m256i       f2[10], gw[20], r[10];
+    int           i, k;
+
+#pragma GCC unroll 10
+    for (i = 0; i < 10; i++) {
+        f2[i] = (i & 1) ? _mm256_add_epi64(f->v[i], f->v[i]) : f->v[i];
+        gw[i] = _mm256_mul_epu32(g->v[i], nineteen); /* g[k - i + 10] */
+        gw[i + 10] = g->v[i];
+    }
+
+#pragma GCC unroll 10
+    for (k = 0; k < 10; k++) {
+        r[k] = _mm256_mul_epu32(f->v[0], gw[k + 10]);
+#pragma GCC unroll 10
+        for (i = 1; i < 10; i++) {
+            r[k] = _mm256_add_epi64(
+                r[k], _mm256_mul_epu32(((k - i) & 1) ? f2[i] : f->v[i],
+                                       gw[k - i + 10]));
+        }
+    }
+    fe4_carry(h, r);
+}
+
+//! `fe4_mul(h, f, f)` with the symmetric products computed once (55 muls).
+static X25519_AVX2 void
+fe4_sq(fe4 *h, const fe4 *f)
+{
+    const __m256i nineteen = _mm256_set1_epi64x(19);
+    __m256i       f2[10], fw[20], r[10], d;
+    int           i, j, k;
+
+#pragma GCC unroll 10
+    for (i = 0; i < 10; i++) {
+        f2[i] = (i & 1) ? _mm256_add_epi64(f->v[i], f->v[i]) : f->v[i];
+        fw[i] = _mm256_mul_epu32(f->v[i], nineteen);
+        fw[i + 10] = f->v[i];
+    }
+
+#pragma GCC unroll 10
+    for (k = 0; k < 10; k++) {
+        d = _mm256_setzero_si256();
+#pragma GCC unroll 10
+        for (i = 0; i < 10; i++) {
+            j = (k - i + 10) % 10;
+            if (j > i) {
+                d = _mm256_add_epi64(
+                    d, _mm256_mul_epu32((j & 1) ? f2[i] : f->v[i],
+                                        fw[k - i + 10]));
+            }
+        }
+        r[k] = _mm256_add_epi64(d, d);
+#pragma GCC unroll 10
+        for (i = 0; i < 10; i++) {
+            if ((2 * i) % 10 == k) {
+                r[k] = _mm256_add_epi64(
+                    r[k], _mm256_mul_epu32((i & 1) ? f2[i] : f->v[i],
+                                           fw[k - i + 10]));
+            }
+        }
+    }
+    fe4_carry(h, r);
+}
+
+static X25519_AVX2 void
+fe4_sqn(fe4 *h, const fe4 *f, int n)
+{
+    fe4_sq(h, f);
+    while (--n > 0) {
+        fe4_sq(h, h);
+    }
+}
+
+static X25519_AVX2 void
+fe4_mul121665(fe4 *h, const fe4 *f)
+{
+    const __m256i a24 = _mm256_set1_epi64x(121665);
+    __m256i       r[10];
+    int           i;
+
+    for (i = 0; i < 10; i++) {
+        r[i] = _mm256_mul_epu32(f->v[i], a24);
+    }
+    fe4_carry(h, r);
+}
+
+static X25519_AVX2 void
+fe4_cswap(fe4 *f, fe4 *g, __m256i mask)
+{
+    __m256i t;
+    int     i;
+
+    for (i = 0; i < 10; i++) {
+        t = _mm256_and_si256(mask, _mm256_xor_si256(f->v[i], g->v[i]));
+        f->v[i] = _mm256_xor_si256(f->v[i], t);
+        g->v[i] = _mm256_xor_si256(g->v[i], t);
+    }
+}
+
+//! `out = z^(p-2)`, same addition chain as the scalar kernels.
+static X25519_AVX2 void
+fe4_invert(fe4 *out, const fe4 *z)
+{
+    fe4 t0, t1, t2, t3;
+
+    fe4_sq(&t0, z);
+    fe4_sqn(&t1, &t0, 2);
+    fe4_mul(&t1, z, &t1);
+    fe4_mul(&t0, &t0, &t1);
+    fe4_sq(&t2, &t0);
+    fe4_mul(&t1, &t1, &t2);
+    fe4_sqn(&t2, &t1, 5);
+    fe4_mul(&t1, &t2, &t1);
+    fe4_sqn(&t2, &t1, 10);
+    fe4_mul(&t2, &t2, &t1);
+    fe4_sqn(&t3, &t2, 20);
+    fe4_mul(&t2, &t3, &t2);
+    fe4_sqn(&t2, &t2, 10);
+    fe4_mul(&t1, &t2, &t1);
+    fe4_sqn(&t2, &t1, 50);
+    fe4_mul(&t2, &t2, &t1);
+    fe4_sqn(&t3, &t2, 100);
+    fe4_mul(&t2, &t3, &t2);
+    fe4_sqn(&t2, &t2, 50);
+    fe4_mul(&t1, &t2, &t1);
+    fe4_sqn(&t1, &t1, 5);
+    fe4_mul(out, &t1, &t0);
+}
+
+X25519_AVX2 void
+crypto_scalarmult_curve25519_x4_avx2(unsigned char q[4][32],
+                                     const unsigned char *const n[4],
+                                     const unsigned char *const p[4])
+{
+    unsigned char k[4][32];
+    fe4           x1, x2, z2, x3, z3, a, b, aa, bb, e, c, d;
+    __m256i       swap = _mm256_setzero_si256(), bit;
+    int           t, l;
+
+    for (l = 0; l < 4; l++) {
+        memcpy(k[l], n[l], 32);
+        k[l][0] &= 248;
+        k[l][31] &= 127;
+        k[l][31] |= 64;
+    }
+
+    fe4_frombytes(&x1, p);
+    memset(&x2, 0, sizeof x2);
+    memset(&z2, 0, sizeof z2);
+    x2.v[0] = _mm256_set1_epi64x(1);
+    fe4_copy(&x3, &x1);
+    memset(&z3, 0, sizeof z3);
+    z3.v[0] = _mm256_set1_epi64x(1);
+
+    for (t = 254; t >= 0; t--) {
+        bit = _mm256_set_epi64x(-(long long) ((k[3][t >> 3] >> (t & 7)) & 1),
+                                -(long long) ((k[2][t >> 3] >> (t & 7)) & 1),
+                                -(long long) ((k[1][t >> 3] >> (t & 7)) & 1),
+                                -(long long) ((k[0][t >> 3] >> (t & 7)) & 1));
+        swap = _mm256_xor_si256(swap, bit);
+        fe4_cswap(&x2, &x3, swap);
+        fe4_cswap(&z2, &z3, swap);
+        swap = bit;
+
+        fe4_add(&a, &x2, &z2);
+        fe4_sub(&b, &x2, &z2);
+        fe4_add(&c, &x3, &z3);
+        fe4_sub(&d, &x3, &z3);
+        fe4_sq(&aa, &a);
+        fe4_sq(&bb, &b);
+        fe4_mul(&d, &d, &a);     /* DA */
+        fe4_mul(&c, &c, &b);     /* CB */
+        fe4_sub(&e, &aa, &bb);
+        fe4_add(&a, &d, &c);
+        fe4_sub(&b, &d, &c);
+        fe4_sq(&x3, &a);
+        fe4_sq(&b, &b);
+        fe4_mul(&z3, &x1, &b);
+        fe4_mul(&x2, &aa, &bb);
+        fe4_mul121665(&a, &e);
+        fe4_add(&a, &a, &aa);
+        fe4_mul(&z2, &e, &a);
+    }
+    fe4_cswap(&x2, &x3, swap);
+    fe4_cswap(&z2, &z3, swap);
+
+    fe4_invert(&z2, &z2);
+    fe4_mul(&x2, &x2, &z2);
+    fe4_tobytes(q, &x2);
+
+    explicit_bzero(k, sizeof k);
+    explicit_bzero(&x2, sizeof x2);
+    explicit_bzero(&z2, sizeof z2);
+    explicit_bzero(&x3, sizeof x3);
+    explicit_bzero(&z3, sizeof z3);
+}
+
+#endif
@@ -0,0 +1,412 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/* Fixed-base X25519 (public keys) through the birationally equivalent
+   twisted Edwards curve: `k * B` is evaluated with a signed radix-16 comb
+   over a table of `j * 256^i * B` (ref10 layout), then mapped to the
+   Montgomery u = (Z + Y) / (Z - Y). The table is built on first use, and a
+   batch of public keys shares one field inversion (Montgomery's trick).
+
+   Table lookups scan every entry with masked moves, and the point formulas
+   have no exceptional cases, so the timing is independent of the scalar. */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "fe25519_51.h"
+#include "x25519_impl.h"
+
+#if defined(__SIZEOF_INT128__)
+
+#if defined(__x86_64__) || defined(__i386__)
+# define CPU_RELAX() __builtin_ia32_pause()
+#else
+# define CPU_RELAX() ((void) 0)
+#endif
+
+/* Edwards points: extended (X:Y:Z:T) with x = X/Z, y = Y/Z, xy = T/Z;
+   completed ((X:Z), (Y:T)) as produced by an addition; and affine
+   precomputed (y + x, y - x, 2dxy) for mixed additions. */
+typedef struct ge_p3 {
+    fe51 X, Y, Z, T;
+} ge_p3;
+
+typedef struct ge_p1p1 {
+    fe51 X, Y, Z, T;
+} ge_p1p1;
+
+typedef struct ge_precomp {
+    fe51 yplusx, yminusx, xy2d;
+} ge_precomp;
+
+/* ed25519 base point (maps to u = 9) and 2d, d = -121665/121666 */
+static const fe51 base_x = { 0x62d608f25d51aULL, 0x412a4b4f6592aULL,
+                             0x75b7171a4b31dULL, 0x1ff60527118feULL,
+                             0x216936d3cd6e5ULL };
+static const fe51 base_y = { 0x6666666666658ULL, 0x4ccccccccccccULL,
+                             0x1999999999999ULL, 0x3333333333333ULL,
+                             0x6666666666666ULL };
+static const fe51 d2 = { 0x69b9426b2f159ULL, 0x35050762add7aULL,
+                         0x3cf44c0038052ULL, 0x6738cc7407977ULL,
+                         0x2406d9dc56dffULL };
+
+//! `table[i][j] = (j + 1) * 256^i * B`
+static ge_precomp table[32][8];
+static int        table_state; /* 0 = empty, 1 = building, 2 = ready */
+
+//! Points per shared inversion in `crypto_scalarmult_curve25519_base_many`.
+#define BATCH 32
+
+static void
+fe51_zero(fe51 h)
+{
+    memset(h, 0, sizeof(fe51));
+}
+
+static void
+fe51_one(fe51 h)
+{
+    memset(h, 0, sizeof(fe51));
+    h[0] = 1;
+}
+
+/*! `out[i] = in[i]^-1` for `count` elements with one inversion and three
+    multiplies per element. No `in[i]` may be zero. `out` may alias `in`. */
+static void
+fe51_batch_invert(fe51 *out, const fe51 *in, fe51 *scratch, size_t count)
+{
+    fe51   acc, t;
+    size_t i;
+
+    memcpy(scratch[0], in[0], sizeof(fe51));
+    for (i = 1; i < count; i++) {
+        fe51_mul(scratch[i], scratch[i - 1], in[i]);
+    }
+    fe51_invert(acc, scratch[count - 1]);
+    for (i = count - 1; i > 0; i--) {
+        fe51_mul(t, acc, scratch[i - 1]);
+        fe51_mul(acc, acc, in[i]);
+        memcpy(out[i], t, sizeof(fe51));
+    }
+    memcpy(out[0], acc, sizeof(fe51));
+}
+
+static void
+ge_p3_0(ge_p3 *h)
+{
+    fe51_zero(h->X);
+    fe51_one(h->Y);
+    fe51_one(h->Z);
+    fe51_zero(h->T);
+}
+
+static void
+ge_p1p1_to_p3(ge_p3 *r, const ge_p1p1 *p)
+{
+    fe51_mul(r->X, p->X, p->T);
+    fe51_mul(r->Y, p->Y, p->Z);
+    fe51_mul(r->Z, p->Z, p->T);
+    fe51_mul(r->T, p->X, p->Y);
+}
+
+//! `r = 2p`; `p->T` is unused.
+static void
+ge_p3_dbl(ge_p1p1 *r, const ge_p3 *p)
+{
+    fe51 t0;
+
+    fe51_sq(r->X, p->X);
+    fe51_sq(r->Z, p->Y);
+    fe51_sq(r->T, p->Z);
+    fe51_add(r->T, r->T, r->T);
+    fe51_add(r->Y, p->X, p->Y);
+    fe51_sq(t0, r->Y);
+    fe51_add(r->Y, r->Z, r->X);
+    fe51_sub(r->Z, r->Z, r->X);
+    fe51_sub_wide(r->X, t0, r->Y);
+    fe51_sub_wide(r->T, r->T, r->Z);
+}
+
+static void
+ge_madd(ge_p1p1 *r, const ge_p3 *p, const ge_precomp *q)
+{
+    fe51 t0;
+
+    fe51_add(r->X, p->Y, p->X);
+    fe51_sub(r->Y, p->Y, p->X);
+    fe51_mul(r->Z, r->X, q->yplusx);
+    fe51_mul(r->Y, r->Y, q->yminusx);
+    fe51_mul(r->T, q->xy2d, p->T);
+    fe51_add(t0, p->Z, p->Z);
+    fe51_sub(r->X, r->Z, r->Y);
+    fe51_add(r->Y, r->Z, r->Y);
+    fe51_add(r->Z, t0, r->T);
+    fe51_sub(r->T, t0, r->T);
+}
+
+//! `out` from affine (x, y); all outputs carried.
+static void
+ge_precomp_from_affine(ge_precomp *out, const fe51 x, const fe51 y)
+{
+    fe51_add(out->yplusx, y, x);
+    fe51_carry(out->yplusx);
+    fe51_sub(out->yminusx, y, x);
+    fe51_carry(out->yminusx);
+    fe51_mul(out->xy2d, x, y);
+    fe51_mul(out->xy2d, out->xy2d, d2);
+}
+
+//! `p` to affine precomputed form for `count` points, one shared inversion.
+static void
+ge_p3_batch_to_precomp(ge_precomp *out, const ge_p3 *p, size_t count)
+{
+    fe51   z[8], zinv[8], scratch[8], x, y;
+    size_t i;
+
+    for (i = 0; i < count; i++) {
+        memcpy(z[i], p[i].Z, sizeof(fe51));
+    }
+    fe51_batch_invert(zinv, z, scratch, count);
+    for (i = 0; i < count; i++) {
+        fe51_mul(x, p[i].X, zinv[i]);
+        fe51_mul(y, p[i].Y, zinv[i]);
+        ge_precomp_from_affine(&out[i], x, y);
+    }
+}
+
+static void
+build_table(void)
+{
+    ge_p3      row[8], point;
+    ge_p1p1    r;
+    ge_precomp base;
+    fe51       zinv;
+    int        i, j;
+
+    /* row base 256^i * B stays affine (Z = 1) for the mixed additions */
+    fe51_one(point.Z);
+    memcpy(point.X, base_x, sizeof(fe51));
+    memcpy(point.Y, base_y, sizeof(fe51));
+    fe51_mul(point.T, base_x, base_y);
+    ge_precomp_from_affine(&base, base_x, base_y);
+
+    for (i = 0; i < 32; i++) {
+        row[0] = point;
+        for (j = 1; j < 8; j++) {
+            ge_madd(&r, &row[j - 1], &base);
+            ge_p1p1_to_p3(&row[j], &r);
+        }
+        ge_p3_batch_to_precomp(table[i], row, 8);
+
+        if (i == 31) {
+            break;
+        }
+        /* next base: 256 * B_i, made affine again */
+        for (j = 0; j < 8; j++) {
+            ge_p3_dbl(&r, &point);
+            ge_p1p1_to_p3(&point, &r);
+        }
+        fe51_invert(zinv, point.Z);
+        fe51_mul(point.X, point.X, zinv);
+        fe51_mul(point.Y, point.Y, zinv);
+        fe51_mul(point.T, point.X, point.Y);
+        ge_precomp_from_affine(&base, point.X, point.Y);
+        fe51_one(point.Z);
+    }
+}
+
+static void
+ensure_table(void)
+{
+    int state = __atomic_load_n(&table_state, __ATOMIC_ACQUIRE);
+    int expected = 0;
+
+    if (state == 2) {
+        return;
+    }
+    if (__atomic_compare_exchange_n(&table_state, &expected, 1, 0,
+                                    __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+        build_table();
+        __atomic_store_n(&table_state, 2, __ATOMIC_RELEASE);
+        return;
+    }
+    /* another thread is building the table (well under a millisecond) */
+    while (__atomic_load_n(&table_state, __ATOMIC_ACQUIRE) != 2) {
+        CPU_RELAX();
+    }
+}
+
+static uint64_t
+equal(signed char b, signed char c)
+{
+    const uint32_t x = (uint32_t) (unsigned char) (b ^ c);
+
+    return (x - 1) >> 31;
+}
+
+static uint64_t
+negative(signed char b)
+{
+    return ((uint64_t) (int64_t) b) >> 63;
+}
+
+static void
+ge_precomp_cmov(ge_precomp *t, const ge_precomp *u, uint64_t b)
+{
+    fe51_cmov(t->yplusx, u->yplusx, b);
+    fe51_cmov(t->yminusx, u->yminusx, b);
+    fe51_cmov(t->xy2d, u->xy2d, b);
+}
+
+//! `t = b * table[pos][0]` for `b` in [-8, 8], scanning the whole row.
+static void
+select_precomp(ge_precomp *t, int pos, signed char b)
+{
+    const uint64_t    bnegative = negative(b);
+    const signed char babs = (signed char) (b - (((-bnegative) & b) * 2));
+    ge_precomp        minust;
+    int               j;
+
+    fe51_one(t->yplusx);
+    fe51_one(t->yminusx);
+    fe51_zero(t->xy2d);
+    for (j = 0; j < 8; j++) {
+        ge_precomp_cmov(t, &table[pos][j], equal(babs, (signed char) (j + 1)));
+    }
+    memcpy(minust.yplusx, t->yminusx, sizeof(fe51));
+    memcpy(minust.yminusx, t->yplusx, sizeof(fe51));
+    fe51_zero(minust.xy2d);
+    fe51_sub(minust.xy2d, minust.xy2d, t->xy2d);
+    ge_precomp_cmov(t, &minust, bnegative);
+}
+
+/*! Edwards `k * B` for the clamped scalar `n`, returned as the numerator
+    and denominator of the Montgomery u-coordinate. */
+static void
+scalarmult_base(fe51 num, fe51 den, const unsigned char n[32])
+{
+    signed char e[64];
+    signed char carry = 0;
+    ge_p3       h;
+    ge_p1p1     r;
+    ge_precomp  t;
+    int         i;
+
+    for (i = 0; i < 32; i++) {
+        unsigned char k = n[i];
+        if (i == 0) {
+            k &= 248;
+        } else if (i == 31) {
+            k = (unsigned char) ((k & 127) | 64);
+        }
+        e[2 * i] = (signed char) (k & 15);
+        e[2 * i + 1] = (signed char) (k >> 4);
+    }
+    /* signed digits in [-8, 8]; e[63] <= 8 since the top bit is clear */
+    for (i = 0; i < 63; i++) {
+        e[i] = (signed char) (e[i] + carry);
+        carry = (signed char) ((e[i] + 8) >> 4);
+        e[i] = (signed char) (e[i] - carry * 16);
+    }
+    e[63] = (signed char) (e[63] + carry);
+
+    ge_p3_0(&h);
+    for (i = 1; i < 64; i += 2) {
+        select_precomp(&t, i / 2, e[i]);
+        ge_madd(&r, &h, &t);
+        ge_p1p1_to_p3(&h, &r);
+    }
+    for (i = 0; i < 4; i++) {
+        ge_p3_dbl(&r, &h);
+        ge_p1p1_to_p3(&h, &r);
+    }
+    for (i = 0; i < 64; i += 2) {
+        select_precomp(&t, i / 2, e[i]);
+        ge_madd(&r, &h, &t);
+        ge_p1p1_to_p3(&h, &r);
+    }
+
+    fe51_add(num, h.Z, h.Y);
+    fe51_sub(den, h.Z, h.Y);
+
+    explicit_bzero(e, sizeof e);
+    explicit_bzero(&h, sizeof h);
+    explicit_bzero(&r, sizeof r);
+    explicit_bzero(&t, sizeof t);
+}
+
+//! \return 1 if `f` is zero mod p.
+static uint64_t
+fe51_iszero(const fe51 f)
+{
+    unsigned char s[32];
+    unsigned char d = 0;
+    int           i;
+
+    fe51_tobytes(s, f);
+    for (i = 0; i < 32; i++) {
+        d |= s[i];
+    }
+    return 1 & ((d - 1U) >> 8);
+}
+
+void
+crypto_scalarmult_curve25519_base_batch(unsigned char (*q)[32],
+                                        const unsigned char *const *n,
+                                        size_t count)
+{
+    fe51     num[BATCH], den[BATCH], scratch[BATCH], one, nil;
+    uint64_t zero;
+    size_t   i, j, chunk;
+
+    ensure_table();
+    fe51_one(one);
+    fe51_zero(nil);
+    for (i = 0; i < count; i += chunk) {
+        chunk = count - i < BATCH ? count - i : BATCH;
+        for (j = 0; j < chunk; j++) {
+            scalarmult_base(num[j], den[j], n[i + j]);
+            /* the identity (u = 0 in the ladder) cannot come from a clamped
+               scalar, but keep it from zeroing the shared inversion */
+            zero = fe51_iszero(den[j]);
+            fe51_cmov(num[j], nil, zero);
+            fe51_cmov(den[j], one, zero);
+        }
+        fe51_batch_invert(den, den, scratch, chunk);
+        for (j = 0; j < chunk; j++) {
+            fe51_mul(num[j], num[j], den[j]);
+            fe51_tobytes(q[i + j], num[j]);
+        }
+    }
+
+    explicit_bzero(num, sizeof num);
+    explicit_bzero(den, sizeof den);
+    explicit_bzero(scratch, sizeof scratch);
+}
+
+#endif
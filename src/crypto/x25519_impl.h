@@ -0,0 +1,85 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef crypto_scalarmult_curve25519_impl_H
+#define crypto_scalarmult_curve25519_impl_H
+
+/* Internal interface between the X25519 front-end (`x25519.c`) and the
+   ladder kernels. Not for use outside of `src/crypto` and the benchmarks. */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! `q = clamp(n) * p`; no check for an all-zero result.
+typedef void (*crypto_scalarmult_curve25519_fn)(unsigned char q[32],
+                                                const unsigned char n[32],
+                                                const unsigned char p[32]);
+
+typedef struct crypto_scalarmult_curve25519_implementation {
+    const char                     *name;
+    crypto_scalarmult_curve25519_fn scalarmult;
+    int                           (*available)(void);
+} crypto_scalarmult_curve25519_implementation;
+
+void crypto_scalarmult_curve25519_ref(unsigned char q[32],
+                                      const unsigned char n[32],
+                                      const unsigned char p[32]);
+#if defined(__SIZEOF_INT128__)
+void crypto_scalarmult_curve25519_51(unsigned char q[32],
+                                     const unsigned char n[32],
+                                     const unsigned char p[32]);
+
+/* `q[i] = clamp(n[i]) * 9` with the fixed-base comb, sharing one field
+   inversion per 32 keys; no check for an all-zero result. */
+void crypto_scalarmult_curve25519_base_batch(unsigned char (*q)[32],
+                                             const unsigned char *const *n,
+                                             size_t count);
+#endif
+#if defined(__x86_64__)
+//! Four independent ladders in AVX2 lanes. \pre CPU support for AVX2.
+void crypto_scalarmult_curve25519_x4_avx2(unsigned char q[4][32],
+                                          const unsigned char *const n[4],
+                                          const unsigned char *const p[4]);
+#endif
+
+/*! \return List of single-ladder kernels compiled into this binary,
+    portable kernel first. Check `available()` before calling a kernel. */
+const crypto_scalarmult_curve25519_implementation *
+crypto_scalarmult_curve25519_implementations(size_t *count);
+
+//! \return Kernel used by `crypto_scalarmult_curve25519`.
+const crypto_scalarmult_curve25519_implementation *
+crypto_scalarmult_curve25519_current_implementation(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
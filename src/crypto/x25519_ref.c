@@ -0,0 +1,230 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Field arithmetic and ladder adapted from TweetNaCl (public domain) by
+// Daniel J. Bernstein, Wesley Janssen, Tanja Lange and Peter Schwabe.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "x25519_impl.h"
+
+/* GF(2^255 - 19) element in 16 signed limbs of 16 bits. Slow but simple;
+   every operation runs the same instruction sequence for any input. */
+typedef int64_t gf[16];
+
+static const gf gf_121665 = { 0xdb41, 1 };
+
+static void
+car25519(gf o)
+{
+    int64_t c;
+    int     i;
+
+    for (i = 0; i < 16; i++) {
+        o[i] += (int64_t) 1 << 16;
+        c = o[i] >> 16;
+        if (i < 15) {
+            o[i + 1] += c - 1;
+        } else {
+            o[0] += 38 * (c - 1);
+        }
+        o[i] -= c * ((int64_t) 1 << 16);
+    }
+}
+
+static void
+sel25519(gf p, gf q, int b)
+{
+    const int64_t c = ~((int64_t) b - 1);
+    int64_t       t;
+    int           i;
+
+    for (i = 0; i < 16; i++) {
+        t = c & (p[i] ^ q[i]);
+        p[i] ^= t;
+        q[i] ^= t;
+    }
+}
+
+static void
+pack25519(unsigned char o[32], const gf n)
+{
+    gf  m, t;
+    int i, j, b;
+
+    memcpy(t, n, sizeof t);
+    car25519(t);
+    car25519(t);
+    car25519(t);
+    for (j = 0; j < 2; j++) {
+        m[0] = t[0] - 0xffed;
+        for (i = 1; i < 15; i++) {
+            m[i] = t[i] - 0xffff - ((m[i - 1] >> 16) & 1);
+            m[i - 1] &= 0xffff;
+        }
+        m[15] = t[15] - 0x7fff - ((m[14] >> 16) & 1);
+        b = (int) ((m[15] >> 16) & 1);
+        m[14] &= 0xffff;
+        sel25519(t, m, 1 - b);
+    }
+    for (i = 0; i < 16; i++) {
+        o[2 * i] = (unsigned char) (t[i] & 0xff);
+        o[2 * i + 1] = (unsigned char) ((t[i] >> 8) & 0xff);
+    }
+}
+
+static void
+unpack25519(gf o, const unsigned char n[32])
+{
+    int i;
+
+    for (i = 0; i < 16; i++) {
+        o[i] = n[2 * i] + ((int64_t) n[2 * i + 1] << 8);
+    }
+    o[15] &= 0x7fff;
+}
+
+static void
+fe_add(gf o, const gf a, const gf b)
+{
+    int i;
+
+    for (i = 0; i < 16; i++) {
+        o[i] = a[i] + b[i];
+    }
+}
+
+static void
+fe_sub(gf o, const gf a, const gf b)
+{
+    int i;
+
+    for (i = 0; i < 16; i++) {
+        o[i] = a[i] - b[i];
+    }
+}
+
+static void
+fe_mul(gf o, const gf a, const gf b)
+{
+    int64_t t[31];
+    int     i, j;
+
+    memset(t, 0, sizeof t);
+    for (i = 0; i < 16; i++) {
+        for (j = 0; j < 16; j++) {
+            t[i + j] += a[i] * b[j];
+        }
+    }
+    for (i = 0; i < 15; i++) {
+        t[i] += 38 * t[i + 16];
+    }
+    memcpy(o, t, sizeof(gf));
+    car25519(o);
+    car25519(o);
+}
+
+static void
+fe_sq(gf o, const gf a)
+{
+    fe_mul(o, a, a);
+}
+
+static void
+fe_invert(gf o, const gf in)
+{
+    gf  c;
+    int a;
+
+    memcpy(c, in, sizeof c);
+    for (a = 253; a >= 0; a--) {
+        fe_sq(c, c);
+        if (a != 2 && a != 4) {
+            fe_mul(c, c, in);
+        }
+    }
+    memcpy(o, c, sizeof c);
+}
+
+void
+crypto_scalarmult_curve25519_ref(unsigned char q[32], const unsigned char n[32],
+                                 const unsigned char p[32])
+{
+    unsigned char z[32];
+    gf            x, a, b, c, dd, e, f;
+    int           i, r;
+
+    memcpy(z, n, 32);
+    z[31] = (n[31] & 127) | 64;
+    z[0] &= 248;
+
+    unpack25519(x, p);
+    memcpy(b, x, sizeof b);
+    memset(a, 0, sizeof a);
+    memset(c, 0, sizeof c);
+    memset(dd, 0, sizeof dd);
+    a[0] = dd[0] = 1;
+
+    for (i = 254; i >= 0; i--) {
+        r = (z[i >> 3] >> (i & 7)) & 1;
+        sel25519(a, b, r);
+        sel25519(c, dd, r);
+        fe_add(e, a, c);
+        fe_sub(a, a, c);
+        fe_add(c, b, dd);
+        fe_sub(b, b, dd);
+        fe_sq(dd, e);
+        fe_sq(f, a);
+        fe_mul(a, c, a);
+        fe_mul(c, b, e);
+        fe_add(e, a, c);
+        fe_sub(a, a, c);
+        fe_sq(b, a);
+        fe_sub(c, dd, f);
+        fe_mul(a, c, gf_121665);
+        fe_add(a, a, dd);
+        fe_mul(c, c, a);
+        fe_mul(a, dd, f);
+        fe_mul(dd, b, x);
+        fe_sq(b, e);
+        sel25519(a, b, r);
+        sel25519(c, dd, r);
+    }
+
+    fe_invert(c, c);
+    fe_mul(a, a, c);
+    pack25519(q, a);
+
+    explicit_bzero(z, sizeof z);
+    explicit_bzero(a, sizeof a);
+    explicit_bzero(b, sizeof b);
+    explicit_bzero(c, sizeof c);
+    explicit_bzero(dd, sizeof dd);
+    explicit_bzero(e, sizeof e);
+    explicit_bzero(f, sizeof f);
+}
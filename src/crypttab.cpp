@@ -0,0 +1,193 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "crypttab.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "batch.hpp"
+#include "error.hpp"
+#include "keyring.hpp"
+
+namespace crypttab
+{
+  namespace
+  {
+    std::error_code last_error() noexcept
+    {
+      return std::error_code{errno, std::system_category()};
+    }
+
+    //! \return Next whitespace separated field of `line`, advancing past it.
+    std::string take_field(span<const char>& line)
+    {
+      const auto space = [] (const char c) { return std::isspace(static_cast<unsigned char>(c)); };
+      const char* begin = std::find_if_not(line.begin(), line.end(), space);
+      const char* end = std::find_if(begin, line.end(), space);
+      line = {end, std::size_t(line.end() - end)};
+      return std::string(begin, end);
+    }
+
+    expect<void> write_all(const int fd, span<const std::uint8_t> key)
+    {
+      while (!key.empty())
+      {
+        const ssize_t written = write(fd, key.data(), key.size());
+        if (written < 0)
+        {
+          if (errno == EINTR)
+            continue;
+          return last_error();
+        }
+        key.remove_prefix(written);
+      }
+      return success();
+    }
+
+    expect<void> write_descriptor(const char* number, const span<const std::uint8_t> key)
+    {
+      char* end = nullptr;
+      const long fd = std::strtol(number, &end, 10);
+      if (end == number || *end != 0 || fd < 3 || 65535 < fd)
+        return {common_error::invalid_argument}; // never stdio
+
+      const expect<void> written = write_all(int(fd), key);
+      if (close(int(fd)) != 0 && written)
+        return last_error();
+      return written;
+    }
+
+    expect<void> write_fifo(const std::string& path, const span<const std::uint8_t> key)
+    {
+      bool created = false;
+      struct stat info{};
+      if (lstat(path.c_str(), &info) != 0)
+      {
+        if (errno != ENOENT)
+          return last_error();
+        if (mkfifo(path.c_str(), 0600) != 0)
+          return last_error();
+        created = true;
+      }
+      else if (!S_ISFIFO(info.st_mode))
+        return {common_error::invalid_argument};
+
+      const int fd = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+      expect<void> written{success()};
+      if (fd < 0)
+        written = last_error();
+      else
+      {
+        written = write_all(fd, key);
+        if (close(fd) != 0 && written)
+          written = last_error();
+      }
+      if (created)
+        unlink(path.c_str());
+      return written;
+    }
+  } // anonymous
+
+  expect<std::vector<volume>> parse(const span<const char> text)
+  {
+    std::vector<volume> out;
+    const char* current = text.begin();
+    while (current != text.end())
+    {
+      const char* end = std::find(current, text.end(), '\n');
+      span<const char> line{current, std::size_t(end - current)};
+      current = (end == text.end()) ? end : end + 1;
+
+      volume entry{};
+      entry.name = take_field(line);
+      if (entry.name.empty() || entry.name[0] == '#')
+        continue;
+
+      take_field(line); // device
+      entry.key_file = take_field(line);
+      const std::string options = take_field(line);
+
+      bool tagged = false;
+      std::size_t begin = 0;
+      while (begin <= options.size())
+      {
+        const std::size_t comma = std::min(options.find(',', begin), options.size());
+        const std::string option = options.substr(begin, comma - begin);
+        begin = comma + 1;
+
+        static constexpr const char identity[] = "macer=";
+        static constexpr const char keyring[] = "macer-keyring=";
+        if (option.compare(0, sizeof(identity) - 1, identity) == 0)
+        {
+          const std::string value = option.substr(sizeof(identity) - 1);
+          const expect<std::vector<host_info>> hosts = batch::parse_manifest({value.data(), value.size()});
+          if (!hosts || hosts->size() != 1)
+            return {common_error::invalid_argument};
+          entry.info = hosts->front();
+          tagged = true;
+        }
+        else if (option == "macer-keyring")
+          entry.keyring = entry.name;
+        else if (option.compare(0, sizeof(keyring) - 1, keyring) == 0)
+        {
+          entry.keyring = option.substr(sizeof(keyring) - 1);
+          if (entry.keyring.empty())
+            return {common_error::invalid_argument};
+        }
+      }
+
+      if (!tagged)
+        continue;
+      if (entry.keyring.empty() && (entry.key_file.empty() || entry.key_file == "none" || entry.key_file == "-"))
+        return {common_error::invalid_argument};
+      out.push_back(std::move(entry));
+    }
+    return out;
+  }
+
+  expect<void> deliver(const volume& target, const span<const std::uint8_t> key)
+  {
+    if (!target.keyring.empty())
+    {
+      const expect<std::int32_t> added = keyring::add(keyring::target::user, target.keyring, key, 0);
+      if (!added)
+        return added.error();
+      return success();
+    }
+
+    static constexpr const char descriptor[] = "/dev/fd/";
+    if (target.key_file.compare(0, sizeof(descriptor) - 1, descriptor) == 0)
+      return write_descriptor(target.key_file.c_str() + sizeof(descriptor) - 1, key);
+    return write_fifo(target.key_file, key);
+  }
+}
@@ -0,0 +1,61 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "expect.hpp"
+#include "host_info.hpp"
+#include "span.hpp"
+
+//! Unlocking every macer volume of a crypttab from one device session.
+namespace crypttab
+{
+  //! An entry with a `macer=[user@]host` option.
+  struct volume
+  {
+    std::string name;     //!< Mapped device name (first field)
+    std::string key_file; //!< Third field: a FIFO path or `/dev/fd/<n>`
+    std::string keyring;  //!< `macer-keyring[=<description>]`; replaces `key_file`
+    host_info info;       //!< Identity the key is derived for
+  };
+
+  /*! \return Entries of crypttab `text` tagged with `macer=[user@]host`, in
+        file order. Other entries, blank lines and `#` comments are skipped.
+        A tagged entry needs a key file or `macer-keyring`. */
+  expect<std::vector<volume>> parse(span<const char> text);
+
+  /*! Deliver `key` to the consumer of `target`: a `user` key in the user
+      keyring, an inherited descriptor (`/dev/fd/<n>`, closed after), or a
+      FIFO at the key file path. The FIFO is created (mode 0600) and removed
+      again if missing, and this blocks until a reader opens it. Regular
+      files are refused so keys never reach a disk. */
+  expect<void> deliver(const volume& target, span<const std::uint8_t> key);
+}
@@ -47,6 +47,10 @@ namespace
                     return "expect<T> was given an error value of zero";
                 case common_error::hash_failure:
                     return "hash failure";
+                case common_error::invalid_mnemonic:
+                    return "invalid BIP-39 mnemonic";
+                case common_error::invalid_checksum:
+                    return "invalid BIP-39 checksum";
                 default:
                     break;
             }
@@ -34,7 +34,9 @@ enum class common_error : int
     // 0 is reserved for no error, as per expect<T>
     invalid_argument = 1, //!< A function argument is invalid
     invalid_error_code,    //!< Default `std::error_code` given to `expect<T>`
-    hash_failure
+    hash_failure,
+    invalid_mnemonic,     //!< Unknown word or word count in BIP-39 input
+    invalid_checksum      //!< BIP-39 checksum does not match entropy
 };
 
 std::error_category const& common_category() noexcept;
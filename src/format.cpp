@@ -0,0 +1,99 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "format.hpp"
+
+#include <iterator>
+#include <vector>
+
+#include "crypto/bip39/encoder.hpp"
+#include "error.hpp"
+#include "radix.hpp"
+
+encoding get_encoding(const format fmt) noexcept
+{
+  switch (fmt)
+  {
+  default:
+  case format::legacy:
+    return {64, 64, false, nullptr};
+  case format::binary:
+    return {32, 32, false, nullptr};
+  case format::bip39_12:
+    return {16, bip39::max_encoded_size(16), true, bip39::encode};
+  case format::bip39_18:
+    return {24, bip39::max_encoded_size(24), true, bip39::encode};
+  case format::bip39_24:
+    return {32, bip39::max_encoded_size(32), true, bip39::encode};
+  case format::base58:
+    return {32, 44, false, radix::base58}; // ceil(256 / log2(58))
+  case format::base32:
+    return {32, 56, false, radix::base32}; // padded to 8 character groups
+  case format::z85:
+    return {32, 40, false, radix::z85};
+  case format::hex:
+    return {32, 64, false, radix::hex};
+  }
+}
+
+expect<byte_slice> encode(const encoding& enc, byte_slice secret)
+{
+  if (secret.size() < enc.size)
+    return {common_error::invalid_argument};
+  secret = secret.get_slice(0, enc.size);
+  if (enc.text)
+    return enc.text(std::move(secret));
+  return secret;
+}
+
+expect<void> encode(const encoding& enc, const span<byte_slice> secrets)
+{
+  for (byte_slice& secret : secrets)
+  {
+    if (secret.size() < enc.size)
+      return {common_error::invalid_argument};
+    secret = secret.get_slice(0, enc.size);
+  }
+
+  if (enc.bip39)
+  {
+    const std::vector<byte_slice> entropy(std::make_move_iterator(secrets.begin()), std::make_move_iterator(secrets.end()));
+    return bip39::encode(to_span(entropy), secrets);
+  }
+
+  if (enc.text)
+  {
+    for (byte_slice& secret : secrets)
+    {
+      expect<byte_slice> text = enc.text(std::move(secret));
+      if (!text)
+        return text.error();
+      secret = std::move(*text);
+    }
+  }
+  return success();
+}
@@ -0,0 +1,57 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstdint>
+
+#include "byte_slice.hpp"
+#include "expect.hpp"
+#include "span.hpp"
+
+//! Output format/strength of a derived password.
+enum class format : std::uint8_t { none = 0, legacy, binary, bip39_12, bip39_18, bip39_24, base58, base32, z85, hex };
+
+//! Secret bytes used by, and text encoding of, an output `format`.
+struct encoding
+{
+  unsigned size;
+  unsigned max_size; //!< Longest `encode` output, in bytes
+  bool bip39; //!< `--verify` decodes the stored mnemonic
+  expect<byte_slice> (*text)(byte_slice); //!< `nullptr` for raw bytes
+};
+
+encoding get_encoding(format fmt) noexcept;
+
+/*! \return First `enc.size` bytes of device or software `secret`, through
+      `enc.text` when set. */
+expect<byte_slice> encode(const encoding& enc, byte_slice secret);
+
+/*! Replace each of `secrets` with its `encode(enc, secret)`. BIP-39
+    checksums are computed in parallel SIMD lanes when available.
+    \return First error from `encode`. */
+expect<void> encode(const encoding& enc, span<byte_slice> secrets);
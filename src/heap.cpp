@@ -0,0 +1,176 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "heap.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+
+namespace heap
+{
+  namespace
+  {
+    struct counters
+    {
+      std::atomic<std::uint64_t> allocations;
+      std::atomic<std::uint64_t> bytes;
+      std::atomic<std::uint64_t> frees;
+    };
+
+    // Zero initialized before any constructor runs, so allocations made
+    // during static initialization are counted safely.
+    counters phases[std::size_t(timing::phase::count) + 1];
+
+#ifdef MACER_HEAP_PROFILE
+    void allocated(const std::size_t size) noexcept
+    {
+      counters& which = phases[std::size_t(timing::active())];
+      which.allocations.fetch_add(1, std::memory_order_relaxed);
+      which.bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void freed() noexcept
+    {
+      phases[std::size_t(timing::active())].frees.fetch_add(1, std::memory_order_relaxed);
+    }
+#endif
+  } // anonymous
+
+  usage get(const timing::phase which) noexcept
+  {
+    const counters& source = phases[std::min(std::size_t(which), std::size_t(timing::phase::count))];
+    return {
+      source.allocations.load(std::memory_order_relaxed),
+      source.bytes.load(std::memory_order_relaxed),
+      source.frees.load(std::memory_order_relaxed)
+    };
+  }
+
+  usage total() noexcept
+  {
+    usage out{};
+    for (std::size_t i = 0; i <= std::size_t(timing::phase::count); ++i)
+    {
+      const usage one = get(timing::phase(i));
+      out.allocations += one.allocations;
+      out.bytes += one.bytes;
+      out.frees += one.frees;
+    }
+    return out;
+  }
+
+  void report(std::FILE* out)
+  {
+    if (!profiled())
+      return;
+
+    std::fprintf(out, "Heap:\n  %-18s %10s %12s %10s\n", "", "allocs", "bytes", "frees");
+    for (std::size_t i = 0; i <= std::size_t(timing::phase::count); ++i)
+    {
+      const usage one = get(timing::phase(i));
+      if (one.allocations || one.frees)
+        std::fprintf(out, "  %-18s %10llu %12llu %10llu\n", timing::name(timing::phase(i)), (unsigned long long)one.allocations, (unsigned long long)one.bytes, (unsigned long long)one.frees);
+    }
+    const usage sum = total();
+    std::fprintf(out, "  %-18s %10llu %12llu %10llu\n", "total", (unsigned long long)sum.allocations, (unsigned long long)sum.bytes, (unsigned long long)sum.frees);
+  }
+}
+
+#ifdef MACER_HEAP_PROFILE
+
+/* glibc exports its allocator under these names, so the replacements below
+   forward without `dlsym` (which can itself allocate). `operator new` in
+   libstdc++ calls `malloc` and is counted too. */
+extern "C"
+{
+  void* __libc_malloc(std::size_t);
+  void* __libc_calloc(std::size_t, std::size_t);
+  void* __libc_realloc(void*, std::size_t);
+  void* __libc_memalign(std::size_t, std::size_t);
+  void* __libc_valloc(std::size_t);
+  void __libc_free(void*);
+
+  void* malloc(const std::size_t size)
+  {
+    heap::allocated(size);
+    return __libc_malloc(size);
+  }
+
+  void* calloc(const std::size_t count, const std::size_t size)
+  {
+    heap::allocated(count * size);
+    return __libc_calloc(count, size);
+  }
+
+  void* realloc(void* const ptr, const std::size_t size)
+  {
+    heap::allocated(size);
+    return __libc_realloc(ptr, size);
+  }
+
+  // aligned allocations are released through `free` too, so count them
+  void* memalign(const std::size_t alignment, const std::size_t size)
+  {
+    heap::allocated(size);
+    return __libc_memalign(alignment, size);
+  }
+
+  void* aligned_alloc(const std::size_t alignment, const std::size_t size)
+  {
+    heap::allocated(size);
+    return __libc_memalign(alignment, size);
+  }
+
+  int posix_memalign(void** const out, const std::size_t alignment, const std::size_t size)
+  {
+    if (alignment % sizeof(void*) || (alignment & (alignment - 1)) || !alignment)
+      return EINVAL;
+    heap::allocated(size);
+    void* const ptr = __libc_memalign(alignment, size);
+    if (!ptr)
+      return ENOMEM;
+    *out = ptr;
+    return 0;
+  }
+
+  void* valloc(const std::size_t size)
+  {
+    heap::allocated(size);
+    return __libc_valloc(size);
+  }
+
+  void free(void* const ptr)
+  {
+    if (ptr)
+      heap::freed();
+    __libc_free(ptr);
+  }
+}
+
+#endif // MACER_HEAP_PROFILE
@@ -0,0 +1,75 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+#include "timing.hpp"
+
+/*! Heap traffic by `timing::phase`. Counting requires a build configured
+    with `--enable-heap-profile`, which replaces `malloc`, `calloc`,
+    `realloc`, the aligned allocators (`posix_memalign`, `aligned_alloc`,
+    `memalign`, `valloc`) and `free`; otherwise every count is zero. */
+namespace heap
+{
+  struct usage
+  {
+    std::uint64_t allocations; //!< Calls to any replaced allocator
+    std::uint64_t bytes;       //!< Bytes requested by those calls
+    std::uint64_t frees;       //!< `free` calls with a non-null pointer
+  };
+
+  //! True when allocations are being counted.
+  constexpr bool profiled() noexcept
+  {
+#ifdef MACER_HEAP_PROFILE
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  /*! \return Heap traffic charged to `which`, from every thread whose
+      innermost `timing::scope` is `which`. `phase::count` is traffic
+      outside of any scope. */
+  usage get(timing::phase which) noexcept;
+
+  //! \return Sum of `get` over every phase, including `phase::count`.
+  usage total() noexcept;
+
+  //! Write non-zero usage by phase to `out` if `profiled()`.
+  void report(std::FILE* out);
+
+  //! Calls `report` on destruction, covering every return path of `main`.
+  struct report_on_exit
+  {
+    std::FILE* out;
+    ~report_on_exit() { report(out); }
+  };
+}
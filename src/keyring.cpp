@@ -0,0 +1,54 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "keyring.hpp"
+
+#include <cerrno>
+#include <linux/keyctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace keyring
+{
+  expect<std::int32_t> add(const target where, const std::string& description, const span<const std::uint8_t> payload, const unsigned timeout)
+  {
+    // glibc has no wrappers; libkeyutils would only wrap these two calls
+    const std::int32_t keyring = where == target::session ? KEY_SPEC_SESSION_KEYRING : KEY_SPEC_USER_KEYRING;
+    const long key = syscall(SYS_add_key, "user", description.c_str(), payload.data(), payload.size(), keyring);
+    if (key < 0)
+      return std::error_code{errno, std::system_category()};
+
+    if (timeout && syscall(SYS_keyctl, KEYCTL_SET_TIMEOUT, key, timeout) != 0)
+    {
+      // never leave behind a key that outlives the requested timeout
+      const std::error_code error{errno, std::system_category()};
+      syscall(SYS_keyctl, KEYCTL_INVALIDATE, key);
+      return error;
+    }
+    return std::int32_t(key);
+  }
+}
@@ -0,0 +1,224 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "macer.h"
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <exception>
+#include <limits>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "error.hpp"
+#include "format.hpp"
+#include "host_info.hpp"
+#include "usb.hpp"
+
+struct macer_context
+{
+  usb::context ctx;
+};
+
+struct macer_device
+{
+  usb::device_handle dev;
+};
+
+namespace
+{
+  static_assert(int(format::legacy) == MACER_FORMAT_LEGACY, "format mismatch");
+  static_assert(int(format::hex) == MACER_FORMAT_HEX, "format mismatch");
+
+  int to_status(const std::error_code error) noexcept
+  {
+    if (error.category() == usb::error_category())
+      return MACER_ERROR_USB;
+    if (error.category() == common_category())
+      return MACER_ERROR_INVALID;
+    if (error.category() == std::system_category() || error.category() == std::generic_category())
+      return MACER_ERROR_SYSTEM;
+    return MACER_ERROR_DEVICE;
+  }
+
+  //! Runs `f`, mapping exceptions to a status; none cross the C boundary.
+  template<typename F>
+  int guarded(F f) noexcept
+  {
+    try
+    {
+      return f();
+    }
+    catch (const std::bad_alloc&)
+    {
+      return MACER_ERROR_SYSTEM;
+    }
+    catch (...)
+    {
+      return MACER_ERROR_DEVICE;
+    }
+  }
+
+  int derive(macer_device* const dev, const macer_identity* const identities, const std::size_t count, const int fmt, void* const out, std::size_t* const size, std::size_t* const sizes)
+  {
+    if (!dev || !dev->dev || !identities || !count || !size || (!out && *size) || fmt < MACER_FORMAT_LEGACY || MACER_FORMAT_HEX < fmt)
+      return MACER_ERROR_INVALID;
+
+    const bool legacy = fmt == MACER_FORMAT_LEGACY;
+    std::vector<host_info> hosts;
+    hosts.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      if (!identities[i].host || !identities[i].host[0])
+        return MACER_ERROR_INVALID;
+      hosts.push_back({identities[i].host, identities[i].user ? identities[i].user : "", legacy ? "" : "GENERATE PASSWORD"});
+    }
+
+    // checked before the device, so a short buffer does not waste a confirmation
+    const std::size_t bound = macer_max_size(fmt, count);
+    if (*size < bound)
+    {
+      *size = bound;
+      return MACER_ERROR_RANGE;
+    }
+
+    const std::atomic<bool> stop{false};
+    expect<std::vector<byte_slice>> keys = usb::run(*dev->dev, to_span(hosts), legacy, stop);
+    if (!keys)
+      return to_status(keys.error());
+
+    const expect<void> encoded = encode(get_encoding(format(fmt)), to_mut_span(*keys));
+    if (!encoded)
+      return to_status(encoded.error());
+
+    unsigned char* const begin = static_cast<unsigned char*>(out);
+    unsigned char* next = begin;
+    for (std::size_t i = 0; i < keys->size(); ++i)
+    {
+      const byte_slice& key = (*keys)[i];
+      if (!key.empty())
+        std::memcpy(next, key.data(), key.size());
+      next += key.size();
+      if (sizes)
+        sizes[i] = key.size();
+    }
+    *size = next - begin;
+    return MACER_OK;
+  }
+} // anonymous
+
+extern "C"
+{
+  int macer_context_open(macer_context** const out)
+  {
+    if (!out)
+      return MACER_ERROR_INVALID;
+    *out = nullptr;
+    return guarded([out] {
+      usb::context ctx = usb::make_context();
+      if (!ctx)
+        return int(MACER_ERROR_USB); // logged by `make_context`
+      *out = new macer_context{std::move(ctx)};
+      return int(MACER_OK);
+    });
+  }
+
+  void macer_context_close(macer_context* const ctx)
+  {
+    delete ctx;
+  }
+
+  int macer_device_open(macer_context* const ctx, macer_device** const out)
+  {
+    if (!ctx || !ctx->ctx || !out)
+      return MACER_ERROR_INVALID;
+    *out = nullptr;
+    return guarded([ctx, out] {
+      expect<usb::device_handle> dev = usb::open(*ctx->ctx);
+      if (!dev)
+        return to_status(dev.error());
+      if (!*dev)
+        return int(MACER_ERROR_NO_DEVICE);
+      *out = new macer_device{std::move(*dev)};
+      return int(MACER_OK);
+    });
+  }
+
+  void macer_device_close(macer_device* const dev)
+  {
+    delete dev;
+  }
+
+  int macer_derive(macer_device* const dev, const char* const user, const char* const host, const int format, void* const out, std::size_t* const size)
+  {
+    const macer_identity identity{user, host};
+    return guarded([&] { return derive(dev, std::addressof(identity), 1, format, out, size, nullptr); });
+  }
+
+  int macer_derive_batch(macer_device* const dev, const macer_identity* const identities, const std::size_t count, const int format, void* const out, std::size_t* const size, std::size_t* const sizes)
+  {
+    if (!sizes)
+      return MACER_ERROR_INVALID;
+    return guarded([&] { return derive(dev, identities, count, format, out, size, sizes); });
+  }
+
+  std::size_t macer_max_size(const int format, const std::size_t count)
+  {
+    if (format < MACER_FORMAT_LEGACY || MACER_FORMAT_HEX < format)
+      return 0;
+    const std::size_t each = get_encoding(::format(format)).max_size;
+    if (std::numeric_limits<std::size_t>::max() / each < count)
+      return std::numeric_limits<std::size_t>::max();
+    return each * count;
+  }
+
+  const char* macer_strerror(const int status)
+  {
+    switch (status)
+    {
+    case MACER_OK:
+      return "Success";
+    case MACER_ERROR_INVALID:
+      return "Invalid argument";
+    case MACER_ERROR_NO_DEVICE:
+      return "No supported device attached";
+    case MACER_ERROR_RANGE:
+      return "Output buffer too small";
+    case MACER_ERROR_USB:
+      return "USB failure";
+    case MACER_ERROR_DEVICE:
+      return "Device failure";
+    case MACER_ERROR_SYSTEM:
+      return "System failure";
+    default:
+      break;
+    }
+    return "Unknown status";
+  }
+}
@@ -0,0 +1,122 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MACER_H
+#define MACER_H
+
+/* C interface to macer password derivation, for services that keep a device
+   open instead of running the `macer` executable per request. Derivation is
+   identical to `macer --host <host> --user <user> --format <format>`.
+
+   PIN and passphrase requests from the device are prompted on the
+   controlling terminal, as with the executable; use a device without PIN
+   and passphrase, or one already unlocked, in headless services. Different
+   devices can be used from different threads; calls on one device must not
+   overlap. */
+
+#include <stddef.h>
+
+#if defined(__GNUC__)
+# define MACER_EXPORT __attribute__((visibility("default")))
+#else
+# define MACER_EXPORT
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Every call returns `MACER_OK` or a negative status. */
+enum macer_status
+{
+  MACER_OK = 0,
+  MACER_ERROR_INVALID = -1,   /* Bad argument, or invalid response from the user */
+  MACER_ERROR_NO_DEVICE = -2, /* No supported device attached */
+  MACER_ERROR_RANGE = -3,     /* Output buffer too small; required size returned */
+  MACER_ERROR_USB = -4,       /* libusb transfer or setup failure */
+  MACER_ERROR_DEVICE = -5,    /* Device reported failure, cancelled or malformed reply */
+  MACER_ERROR_SYSTEM = -6     /* Out of memory or other system failure */
+};
+
+/* Output format/strength, same as `--format`. */
+enum macer_format
+{
+  MACER_FORMAT_LEGACY = 1,
+  MACER_FORMAT_BINARY,
+  MACER_FORMAT_BIP39_12,
+  MACER_FORMAT_BIP39_18,
+  MACER_FORMAT_BIP39_24,
+  MACER_FORMAT_BASE58,
+  MACER_FORMAT_BASE32,
+  MACER_FORMAT_Z85,
+  MACER_FORMAT_HEX
+};
+
+/* `user` may be NULL or empty. */
+struct macer_identity
+{
+  const char* user;
+  const char* host;
+};
+
+typedef struct macer_context macer_context;
+typedef struct macer_device macer_device;
+
+/* Create a libusb context in `*out`. Close with `macer_context_close`. */
+MACER_EXPORT int macer_context_open(macer_context** out);
+MACER_EXPORT void macer_context_close(macer_context* ctx);
+
+/* Open and claim the first supported device in `*out`, or return
+   `MACER_ERROR_NO_DEVICE`. The device must be closed before `ctx`. */
+MACER_EXPORT int macer_device_open(macer_context* ctx, macer_device** out);
+MACER_EXPORT void macer_device_close(macer_device* dev);
+
+/* Largest total password size of `count` identities in `format`, or 0
+   for an unknown format. */
+MACER_EXPORT size_t macer_max_size(int format, size_t count);
+
+/* Derive the password of `user`@`host` into `out`, which has `*size`
+   bytes. On success `*size` is the password length (text is not NUL
+   terminated). When `*size` is less than `macer_max_size(format, 1)`,
+   `MACER_ERROR_RANGE` is returned with that size, before the device is
+   asked. Blocks until the request is confirmed on the device. */
+MACER_EXPORT int macer_derive(macer_device* dev, const char* user, const char* host, int format, void* out, size_t* size);
+
+/* `macer_derive` for `count` identities from one device session (PIN and
+   passphrase entered once). Passwords are written back to back into `out`,
+   with the length of each in `sizes[i]`; `*size` is handled as in
+   `macer_derive`, against `macer_max_size(format, count)`. */
+MACER_EXPORT int macer_derive_batch(macer_device* dev, const struct macer_identity* identities, size_t count, int format, void* out, size_t* size, size_t* sizes);
+
+/* Static string describing `status`. */
+MACER_EXPORT const char* macer_strerror(int status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MACER_H */
@@ -26,23 +26,57 @@
 // THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
-#include "crypto/bip39/encoder.hpp"
+#include <limits>
+#include <fcntl.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "batch.hpp"
+#include "byte_chain.hpp"
+#include "byte_stream.hpp"
+#include "crypttab.hpp"
+#include "format.hpp"
+#include "crypto/bip39/decoder.hpp"
+#include "heap.hpp"
 #include "host_info.hpp"
+#include "keyring.hpp"
 #include "logger.hpp"
+#include "memfd.hpp"
+#include "metrics.hpp"
 #include "password.hpp"
+#include "thread_pool.hpp"
+#include "timing.hpp"
+#include "trace.hpp"
+#include "trezor/identity.hpp"
+#include "trezor/software.hpp"
 #include "usb.hpp"
 
 namespace
 {
-  enum class format : std::uint8_t { none = 0, legacy, binary, bip39_12, bip39_18, bip39_24 };
   struct program
   {
     host_info info;
+    std::string verify;
+    std::string batch;
+    std::string crypttab;
+    std::string derive;
+    std::string trace_file;
+    std::string metrics_file;
+    std::string keyring;
+    std::string output_memfd;
+    unsigned keyring_timeout;
+    unsigned threads;
     format fmt;
     bool existing;
+    bool keyring_session;
     bool password;
+    bool software;
     bool failed;
   };
   typedef const char**(*argument_handler)(program&, const char*[]);
@@ -73,6 +107,18 @@ namespace
     return ++argv;
   }
 
+  const char** handle_batch(program& prog, const char* argv[])
+  {
+    return basic_handler(prog, prog.batch, "batch", argv);
+  }
+  const char** handle_crypttab(program& prog, const char* argv[])
+  {
+    return basic_handler(prog, prog.crypttab, "crypttab", argv);
+  }
+  const char** handle_derive(program& prog, const char* argv[])
+  {
+    return basic_handler(prog, prog.derive, "derive", argv);
+  }
   const char** handle_existing(program& prog, const char* argv[])
   {
     prog.existing = true;
@@ -116,6 +162,14 @@ namespace
       prog.fmt = format::bip39_18;
     else if (strcmp("bip39-24", argv[0]) == 0)
       prog.fmt = format::bip39_24;
+    else if (strcmp("base58", argv[0]) == 0)
+      prog.fmt = format::base58;
+    else if (strcmp("base32", argv[0]) == 0)
+      prog.fmt = format::base32;
+    else if (strcmp("z85", argv[0]) == 0)
+      prog.fmt = format::z85;
+    else if (strcmp("hex", argv[0]) == 0)
+      prog.fmt = format::hex;
     else
     {
       prog.failed = true;
@@ -128,6 +182,35 @@ namespace
   {
     return basic_handler(prog, prog.info.host, "host", argv);
   }
+  const char** handle_keyring(program& prog, const char* argv[])
+  {
+    return basic_handler(prog, prog.keyring, "keyring", argv);
+  }
+  const char** handle_keyring_session(program& prog, const char* argv[])
+  {
+    prog.keyring_session = true;
+    return argv;
+  }
+  const char** handle_keyring_timeout(program& prog, const char* argv[])
+  {
+    if (!argv || !argv[0])
+    {
+      prog.failed = true;
+      fprintf(stderr, "Missing argument for --keyring-timeout\n");
+      return nullptr;
+    }
+
+    char* end = nullptr;
+    const unsigned long value = std::strtoul(argv[0], &end, 10);
+    if (end == argv[0] || *end != 0 || value == 0 || std::numeric_limits<unsigned>::max() < value)
+    {
+      prog.failed = true;
+      fprintf(stderr, "Invalid --keyring-timeout value\n");
+      return nullptr;
+    }
+    prog.keyring_timeout = unsigned(value);
+    return ++argv;
+  }
   const char** handle_user(program& prog, const char* argv[])
   {
     return basic_handler(prog, prog.info.user, "user", argv);
@@ -142,21 +225,83 @@ namespace
     }
     return basic_handler(prog, prog.info.message, "message", argv);
   }
+  const char** handle_metrics_file(program& prog, const char* argv[])
+  {
+    return basic_handler(prog, prog.metrics_file, "metrics-file", argv);
+  }
+  const char** handle_output_memfd(program& prog, const char* argv[])
+  {
+    return basic_handler(prog, prog.output_memfd, "output-memfd", argv);
+  }
   const char** handle_password(program& prog, const char* argv[])
   {
     prog.password = true;
     return argv;
   }
+  const char** handle_software(program& prog, const char* argv[])
+  {
+    prog.software = true;
+    return argv;
+  }
+  const char** handle_trace_file(program& prog, const char* argv[])
+  {
+    argv = basic_handler(prog, prog.trace_file, "trace-file", argv);
+    if (argv)
+      trace::enable();
+    return argv;
+  }
+  const char** handle_trace_timing(program&, const char* argv[])
+  {
+    timing::enable();
+    return argv;
+  }
+  const char** handle_threads(program& prog, const char* argv[])
+  {
+    if (!argv || !argv[0])
+    {
+      prog.failed = true;
+      fprintf(stderr, "Missing argument for --threads\n");
+      return nullptr;
+    }
+
+    char* end = nullptr;
+    const unsigned long value = std::strtoul(argv[0], &end, 10);
+    if (end == argv[0] || *end != 0 || value == 0 || 1024 < value)
+    {
+      prog.failed = true;
+      fprintf(stderr, "Invalid --threads value\n");
+      return nullptr;
+    }
+    prog.threads = unsigned(value);
+    return ++argv;
+  }
+  const char** handle_verify(program& prog, const char* argv[])
+  {
+    return basic_handler(prog, prog.verify, "verify", argv);
+  }
   
   constexpr const argument process_args[] =
   {
     {nullptr, "help", "\t\tList help", 'h'},
+    {handle_batch, "batch", "[file]\tDerive every [user@]host line of file (with --software)", 'b'},
+    {handle_crypttab, "crypttab", "[file]\tDeliver keys for each macer= entry of crypttab file from one device session", 'c'},
+    {handle_derive, "derive", "[labels]\tOne password per comma separated label from a single device confirmation", 'd'},
     {handle_existing, "existing", "\t\tPrompt for existing LUKS password for adding new key", 'e'},
-    {handle_format, "format", "[format]\tOutput format/strength -> legacy | binary | bip39-12 | bip39-18 | bip39-24", 'f'},
+    {handle_format, "format", "[format]\tOutput format/strength -> legacy | binary | bip39-12 | bip39-18 | bip39-24 | base58 | base32 | z85 | hex", 'f'},
     {handle_host, "host", "[hostname]\tIdentity hostname for password", 't'},
+    {handle_keyring, "keyring", "[description]\tAdd password to the kernel user keyring instead of writing to stdout", 'k'},
+    {handle_keyring_session, "keyring-session", "\tUse the session keyring for --keyring", 'K'},
+    {handle_keyring_timeout, "keyring-timeout", "[seconds]\tExpire the --keyring key after seconds", 'x'},
     {handle_user, "user", "[user]\t\tIdentity username for password", 'u'},
     {handle_message, "message", "[message]\tMessage to display on device (legacy format only)", 'm'},
-    {handle_password, "password", "\t\tPrompt for local only password to append to stdout (more entropy)", 'p'}
+    {handle_metrics_file, "metrics-file", "[file]\tRewrite Prometheus textfile of device metrics every 15 seconds", 'M'},
+    {handle_output_memfd, "output-memfd", "[target]\tWrite output to a sealed memfd for `unix:socket` or command ($MACER_MEMFD)", 'o'},
+    {handle_password, "password", "\t\tPrompt for local only password to append to stdout (more entropy)", 'p'},
+    {handle_software, "software", "\t\tDerive from BIP-39 mnemonic instead of device (offline recovery)", 's'},
+    {handle_threads, "threads", "[count]\tWorker threads for --batch (default one per CPU)", 'j'},
+    {handle_trace_file, "trace-file", "[file]\tWrite a Chrome trace JSON timeline of the device exchange to file", 'F'},
+    {handle_trace_timing, "trace-timing", "\t\tPrint time spent in each phase to stderr, human waits separately", 'T'},
+    {handle_verify, "verify", "[file]\tCompare against password stored in file instead of writing to stdout", 'v'}
   };
 
   template<typename F>
@@ -189,6 +334,486 @@ namespace
     ++argv;
     return current->handler(prog, argv);
   }
+
+  /*! \return Comma separated `--derive` labels. Labels cannot be empty or
+        contain a tab or newline, which would break the output lines. */
+  expect<std::vector<std::string>> split_labels(const std::string& list)
+  {
+    std::vector<std::string> out;
+    std::size_t begin = 0;
+    for (;;)
+    {
+      const std::size_t end = std::min(list.find(',', begin), list.size());
+      std::string label = list.substr(begin, end - begin);
+      if (label.empty() || label.find_first_of("\t\n") != std::string::npos)
+        return {common_error::invalid_argument};
+      out.push_back(std::move(label));
+      if (end == list.size())
+        break;
+      begin = end + 1;
+    }
+    return out;
+  }
+
+  /*! Device exchange thread. On every return path of `main` it is told to
+      `stop` (seen at its next read poll or prompt) and joined. */
+  struct device_thread
+  {
+    std::atomic<bool> stop{false};
+    std::thread thread{};
+
+    ~device_thread()
+    {
+      stop = true;
+      if (thread.joinable())
+        thread.join();
+    }
+  };
+
+  //! `password_prompt`, timed as human wait.
+  expect<std::string> prompt(const char* message, const bool confirm = false)
+  {
+    const timing::scope wait{timing::phase::prompt};
+    return password_prompt(message, confirm);
+  }
+
+  expect<slip10::seed> software_seed()
+  {
+    const expect<std::string> mnemonic = prompt("BIP-39 mnemonic");
+    if (!mnemonic)
+      return mnemonic.error();
+    const expect<std::string> passphrase = prompt("Trezor Passphrase");
+    if (!passphrase)
+      return passphrase.error();
+    return trezor::software::make_seed(to_span(*mnemonic), to_span(*passphrase));
+  }
+
+  expect<byte_slice> software_secret(const host_info& info)
+  {
+    const expect<slip10::seed> seed = software_seed();
+    if (!seed)
+      return seed.error();
+    return trezor::software::run(*seed, info);
+  }
+
+  /*! \return Secret for each of `hosts` from one device session, retried
+        after a prompt until a device is attached. Runs on its own thread
+        until done or `stop`; errors before `stop` are logged here. */
+  expect<std::vector<byte_slice>> device_secrets(const program& prog, const span<const host_info> hosts, const std::atomic<bool>& stop)
+  {
+    const usb::context ctx = usb::make_context();
+    if (!ctx)
+      return {usb::error(LIBUSB_ERROR_OTHER)}; // logged by `make_context`
+
+    while (true)
+    {
+      expect<std::vector<byte_slice>> secrets = usb::run(*ctx, hosts, prog.fmt == format::legacy, stop);
+      if (!secrets)
+      {
+        if (!stop)
+          MACER_LOG_ERROR(secrets.error());
+        return secrets;
+      }
+      if (!secrets->empty())
+        return secrets;
+
+      const terminal_lock exclusive{}; // `stop` is set before a failed prompt releases it
+      if (stop)
+        return {std::make_error_code(std::errc::operation_canceled)};
+      fprintf(stderr, "Attach compatible device  (press any key when ready)...\n");
+      if (timing::measure(timing::phase::prompt, [] { return getchar(); }) == EOF)
+      {
+        fprintf(stderr, "No input available, quitting\n");
+        return {common_error::invalid_argument};
+      }
+    }
+  }
+
+  //! \return `device_secrets` for `--host`/`--user` alone.
+  expect<byte_slice> device_secret(const program& prog, const std::atomic<bool>& stop)
+  {
+    expect<std::vector<byte_slice>> secrets = device_secrets(prog, {std::addressof(prog.info), 1}, stop);
+    if (!secrets)
+      return secrets.error();
+    return std::move(secrets->front());
+  }
+
+  expect<byte_slice> read_file(const char* path)
+  {
+    const int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      return std::error_code{errno, std::system_category()};
+
+    byte_stream out{};
+    std::uint8_t buffer[4096];
+    while (true)
+    {
+      const ssize_t rc = read(fd, buffer, sizeof(buffer));
+      if (rc < 0)
+      {
+        if (errno == EINTR)
+          continue;
+        const std::error_code error{errno, std::system_category()};
+        close(fd);
+        return error;
+      }
+      if (rc == 0)
+        break;
+      out.write(buffer, std::size_t(rc));
+    }
+    close(fd);
+    return byte_slice{std::move(out)};
+  }
+
+  //! \return True iff `left == right`; timing depends only on sizes.
+  bool constant_compare(const span<const std::uint8_t> left, const span<const std::uint8_t> right) noexcept
+  {
+    if (left.size() != right.size())
+      return false;
+
+    std::uint8_t diff = 0;
+    for (std::size_t i = 0; i < left.size(); ++i)
+      diff |= left[i] ^ right[i];
+    return diff == 0;
+  }
+
+  /*! Compare device output `secret` and `local` passphrase against the
+      contents of `path`. Mnemonics are decoded and compared as entropy
+      bytes (`secret` is not BIP-39 encoded), so whitespace differences are
+      ignored; other formats are compared as encoded text.
+
+      \return 0 on match, 1 on mismatch, -1 on error. */
+  int verify(const char* path, const byte_slice& secret, const bool bip39_output, const expect<std::string>& local)
+  {
+    expect<byte_slice> stored = read_file(path);
+    if (!stored)
+    {
+      MACER_LOG_ERROR(stored.error());
+      return -1;
+    }
+
+    bool match = true;
+    if (local)
+    {
+      const span<const std::uint8_t> suffix = strspan<std::uint8_t>(*local);
+      const std::size_t split = stored->size() - std::min(stored->size(), suffix.size());
+      match = constant_compare({stored->data() + split, stored->size() - split}, suffix);
+      stored = stored->get_slice(0, split);
+    }
+
+    if (bip39_output)
+    {
+      const span<const char> text{reinterpret_cast<const char*>(stored->data()), stored->size()};
+      stored = bip39::decode(text);
+      if (!stored)
+      {
+        fprintf(stderr, "Stored password: %s\n", stored.error().message().c_str());
+        return 1;
+      }
+    }
+
+    match &= constant_compare(to_span(*stored), to_span(secret));
+    fprintf(stderr, match ? "Password matches\n" : "Password does NOT match\n");
+    return match ? 0 : 1;
+  }
+  /*! \return `STDOUT_FILENO`, or a new `--output-memfd` file stored in
+        `memfd`. -1 on error. */
+  int open_output(const program& prog, memfd::file& memfd)
+  {
+    if (prog.output_memfd.empty())
+      return STDOUT_FILENO;
+
+    expect<memfd::file> created = memfd::file::create("macer");
+    if (!created)
+    {
+      MACER_LOG_ERROR(created.error(), "--output-memfd");
+      return -1;
+    }
+    memfd = std::move(*created);
+    return memfd.get();
+  }
+
+  /*! Seal the `--output-memfd` file and hand it off.
+      \return 0 on success, -1 on error, or the non-zero exit status of the
+        `--output-memfd` command. */
+  int close_output(const program& prog, memfd::file memfd)
+  {
+    if (prog.output_memfd.empty())
+      return 0;
+
+    const expect<int> status = timing::measure(timing::phase::output, [&] {
+      return memfd::hand_off(std::move(memfd), prog.output_memfd);
+    });
+    if (!status)
+    {
+      MACER_LOG_ERROR(status.error(), "--output-memfd");
+      return -1;
+    }
+    return *status;
+  }
+
+  /*! Add `secret`, followed by the `--password` passphrase if any (as on
+      stdout), to the `--keyring` keyring as `description`, and print the key
+      serial number to stdout.
+      \return 0 on success, -1 on error. */
+  int store_key(const program& prog, const std::string& description, const byte_slice& secret, const expect<std::string>& local)
+  {
+    const keyring::target where = prog.keyring_session ? keyring::target::session : keyring::target::user;
+    expect<std::int32_t> key{common_error::invalid_argument};
+    if (!local)
+      key = timing::measure(timing::phase::output, [&] { return keyring::add(where, description, to_span(secret), prog.keyring_timeout); });
+    else
+    {
+      std::vector<std::uint8_t> payload(secret.begin(), secret.end());
+      payload.insert(payload.end(), local->begin(), local->end());
+      key = timing::measure(timing::phase::output, [&] { return keyring::add(where, description, to_span(payload), prog.keyring_timeout); });
+      explicit_bzero(payload.data(), payload.size());
+    }
+
+    if (!key)
+    {
+      MACER_LOG_ERROR(key.error(), "--keyring");
+      return -1;
+    }
+    std::printf("%d\n", int(*key));
+    return 0;
+  }
+
+  /*! Expand `session` once per `--derive` label and write one
+      `label<TAB>password` line per label, in argument order. With
+      `--keyring`, each password is instead added as a key named the
+      description followed by the label.
+      \return 0 on success, -1 on error. */
+  int run_derive(const program& prog, const std::vector<std::string>& labels, const byte_slice& session, const encoding& enc)
+  {
+    assert(enc.text);
+    byte_chain output{};
+    for (const std::string& label : labels)
+    {
+      expect<byte_slice> secret = timing::measure(timing::phase::hashing, [&] {
+        return trezor::expand_secret(to_span(session), to_span(label), enc.size);
+      });
+      if (secret)
+        secret = timing::measure(timing::phase::encoding, [&] { return enc.text(std::move(*secret)); });
+      if (!secret)
+      {
+        MACER_LOG_ERROR(secret.error());
+        return -1;
+      }
+
+      if (!prog.keyring.empty())
+      {
+        if (store_key(prog, prog.keyring + label, *secret, {common_error::invalid_argument}) != 0)
+          return -1;
+        continue;
+      }
+
+      static constexpr const std::uint8_t tab[] = {'\t'};
+      static constexpr const std::uint8_t newline[] = {'\n'};
+      output.push_back(byte_slice{{strspan<std::uint8_t>(label), tab}});
+      output.push_back(std::move(*secret));
+      output.push_back(byte_slice{{newline}});
+    }
+
+    if (!prog.keyring.empty())
+      return 0;
+
+    memfd::file memfd{};
+    const int fd = open_output(prog, memfd);
+    if (fd < 0)
+      return -1;
+
+    const expect<void> written = timing::measure(timing::phase::output, [&] { return output.write(fd); });
+    if (!written)
+    {
+      MACER_LOG_ERROR(written.error());
+      return -1;
+    }
+    return close_output(prog, std::move(memfd));
+  }
+
+  /*! Derive a key for every `macer=` volume of the `--crypttab` file from
+      one device session (or one `--software` seed), then deliver each to
+      its key file or keyring. Deliveries run concurrently since each FIFO
+      blocks until its reader opens it.
+      \return 0 on success, -1 on error. */
+  int run_crypttab(const program& prog)
+  {
+    const expect<byte_slice> text = read_file(prog.crypttab.c_str());
+    if (!text)
+    {
+      MACER_LOG_ERROR(text.error(), prog.crypttab.c_str());
+      return -1;
+    }
+
+    const expect<std::vector<crypttab::volume>> volumes = crypttab::parse({reinterpret_cast<const char*>(text->data()), text->size()});
+    if (!volumes)
+    {
+      fprintf(stderr, "Invalid --crypttab entry: %s\n", volumes.error().message().c_str());
+      return -1;
+    }
+    if (volumes->empty())
+    {
+      fprintf(stderr, "No macer= entries in %s\n", prog.crypttab.c_str());
+      return -1;
+    }
+
+    std::vector<host_info> hosts;
+    hosts.reserve(volumes->size());
+    for (const crypttab::volume& entry : *volumes)
+      hosts.push_back(entry.info);
+
+    expect<std::vector<byte_slice>> secrets{common_error::invalid_argument};
+    device_thread device{};
+    if (!prog.software)
+      device.thread = std::thread{[&secrets, &prog, &hosts, &device] { secrets = device_secrets(prog, to_span(hosts), device.stop); }};
+
+    expect<std::string> local{common_error::invalid_argument};
+    if (prog.password)
+    {
+      const terminal_lock exclusive{}; // device prompts see `stop` if this fails
+      local = prompt("Local passphrase");
+      if (!local)
+      {
+        device.stop = true;
+        MACER_LOG_ERROR(local.error());
+        return -1;
+      }
+    }
+
+    if (prog.software)
+    {
+      secrets = timing::measure(timing::phase::software, [&] () -> expect<std::vector<byte_slice>> {
+        const expect<slip10::seed> seed = software_seed();
+        if (!seed)
+          return seed.error();
+        return trezor::software::run(*seed, to_span(hosts));
+      });
+      if (!secrets)
+      {
+        MACER_LOG_ERROR(secrets.error());
+        return -1;
+      }
+    }
+    else
+    {
+      device.thread.join();
+      if (!secrets)
+        return -1; // logged by `device_secrets`
+    }
+
+    const encoding enc = get_encoding(prog.fmt);
+    std::vector<byte_slice> keys;
+    keys.reserve(secrets->size());
+    for (byte_slice& secret : *secrets)
+    {
+      expect<byte_slice> key = timing::measure(timing::phase::encoding, [&] { return encode(enc, std::move(secret)); });
+      if (!key)
+      {
+        MACER_LOG_ERROR(key.error());
+        return -1;
+      }
+      if (local)
+        key = byte_slice{{to_span(*key), strspan<std::uint8_t>(*local)}};
+      keys.push_back(std::move(*key));
+    }
+
+    std::vector<expect<void>> delivered(keys.size(), expect<void>{common_error::invalid_argument});
+    {
+      const timing::scope output{timing::phase::output};
+      std::vector<std::thread> consumers;
+      consumers.reserve(keys.size());
+      for (std::size_t i = 0; i < keys.size(); ++i)
+      {
+        consumers.emplace_back([&delivered, &keys, &volumes, i] {
+          delivered[i] = crypttab::deliver((*volumes)[i], to_span(keys[i]));
+        });
+      }
+      for (std::thread& consumer : consumers)
+        consumer.join();
+    }
+
+    int status = 0;
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+      if (!delivered[i])
+      {
+        MACER_LOG_ERROR(delivered[i].error(), (*volumes)[i].name.c_str());
+        status = -1;
+      }
+    }
+    return status;
+  }
+
+  /*! Derive every identity in the `--batch` manifest and write one
+      `[user@]host<TAB>password` line per entry, in manifest order.
+      \return 0 on success, -1 on error. */
+  int run_batch(const program& prog)
+  {
+    expect<batch::mapped_file> manifest = batch::mapped_file::open(prog.batch.c_str());
+    if (!manifest)
+    {
+      MACER_LOG_ERROR(manifest.error());
+      return -1;
+    }
+
+    const expect<slip10::seed> seed = timing::measure(timing::phase::software, software_seed);
+    if (!seed)
+    {
+      MACER_LOG_ERROR(seed.error());
+      return -1;
+    }
+
+    const encoding enc = get_encoding(prog.fmt);
+    const auto encode = [enc] (const span<const host_info> hosts, span<byte_slice> secrets) -> expect<void>
+    {
+      MACER_CHECK(::encode(enc, secrets));
+      for (std::size_t i = 0; i < hosts.size(); ++i)
+      {
+        const host_info& info = hosts[i];
+        byte_stream line{};
+        line.reserve(info.user.size() + info.host.size() + secrets[i].size() + 3);
+        if (!info.user.empty())
+        {
+          line.write(to_span(info.user));
+          line.put('@');
+        }
+        line.write(to_span(info.host));
+        line.put('\t');
+        line.write(to_span(secrets[i]));
+        line.put('\n');
+        secrets[i] = byte_slice{std::move(line)};
+      }
+      return success();
+    };
+
+    // output is written by a separate thread through two 64 KiB buffers
+    memfd::file memfd{};
+    const int fd = open_output(prog, memfd);
+    if (fd < 0)
+      return -1;
+
+    thread_pool pool{prog.threads};
+    batch::output_writer output{fd, 64 * 1024};
+    const expect<void> derived = timing::measure(timing::phase::software, [&] {
+      return batch::stream(pool, *seed, *manifest, encode, output);
+    });
+    const expect<void> written = output.finish();
+    if (!derived)
+    {
+      if (derived.error() == common_error::invalid_argument)
+        fprintf(stderr, "Invalid --batch manifest: %s\n", derived.error().message().c_str());
+      else
+        MACER_LOG_ERROR(derived.error());
+      return -1;
+    }
+    if (!written)
+    {
+      MACER_LOG_ERROR(written.error());
+      return -1;
+    }
+    return close_output(prog, std::move(memfd));
+  }
 }
 
 int main(int, const char* argv[])
@@ -199,19 +824,110 @@ int main(int, const char* argv[])
     return -1;
   }
 
+  const heap::report_on_exit heap_report{stderr};
+  const timing::report_on_exit report{stderr};
+
   ++argv;
   program prog{};
-  while (argv = process_argument(prog, argv));
+  {
+    const timing::scope parse{timing::phase::arguments};
+    while (argv = process_argument(prog, argv));
+  }
   if (prog.failed)
     return -1;
+  const trace::write_on_exit traced{prog.trace_file};
+  const metrics::exporter exported{prog.metrics_file, std::chrono::seconds{15}};
+
+  if (!prog.verify.empty() && prog.existing)
+  {
+    fprintf(stderr, "Cannot use --existing with --verify\n");
+    return -1;
+  }
+
+  if (!prog.batch.empty())
+  {
+    if (!prog.software)
+    {
+      fprintf(stderr, "--batch requires --software\n");
+      return -1;
+    }
+    if (prog.existing || prog.password || !prog.verify.empty() || !prog.info.host.empty() || !prog.info.user.empty())
+    {
+      fprintf(stderr, "Cannot use --existing, --password, --verify, --host or --user with --batch\n");
+      return -1;
+    }
+    if (prog.fmt == format::binary)
+    {
+      fprintf(stderr, "Cannot use binary format with --batch\n");
+      return -1;
+    }
+  }
+  else if (prog.threads)
+  {
+    fprintf(stderr, "--threads requires --batch\n");
+    return -1;
+  }
 
-  if (is_cout_tty())
+  std::vector<std::string> labels;
+  if (!prog.derive.empty())
+  {
+    expect<std::vector<std::string>> split = split_labels(prog.derive);
+    if (!split)
+    {
+      fprintf(stderr, "Invalid --derive labels\n");
+      return -1;
+    }
+    labels = std::move(*split);
+
+    if (!prog.batch.empty() || prog.fmt == format::legacy)
+    {
+      fprintf(stderr, "Cannot use --derive with --batch or legacy format\n");
+      return -1;
+    }
+    if (1 < labels.size() && (prog.existing || prog.password || !prog.verify.empty() || prog.fmt == format::binary))
+    {
+      fprintf(stderr, "Cannot use --existing, --password, --verify or binary format with multiple --derive labels\n");
+      return -1;
+    }
+  }
+
+  if (!prog.crypttab.empty())
+  {
+    if (!prog.info.host.empty() || !prog.info.user.empty() || !prog.batch.empty() || !prog.derive.empty())
+    {
+      fprintf(stderr, "Cannot use --host, --user, --batch or --derive with --crypttab\n");
+      return -1;
+    }
+    if (prog.existing || !prog.verify.empty() || !prog.keyring.empty() || !prog.output_memfd.empty())
+    {
+      fprintf(stderr, "Cannot use --existing, --verify, --keyring or --output-memfd with --crypttab\n");
+      return -1;
+    }
+  }
+
+  if (prog.keyring.empty() && (prog.keyring_session || prog.keyring_timeout))
+  {
+    fprintf(stderr, "--keyring-session and --keyring-timeout require --keyring\n");
+    return -1;
+  }
+  if (!prog.keyring.empty() && (prog.existing || !prog.verify.empty() || !prog.batch.empty()))
+  {
+    fprintf(stderr, "Cannot use --existing, --verify or --batch with --keyring\n");
+    return -1;
+  }
+  if (!prog.output_memfd.empty() && (!prog.keyring.empty() || !prog.verify.empty()))
+  {
+    fprintf(stderr, "Cannot use --keyring or --verify with --output-memfd\n");
+    return -1;
+  }
+
+  if (prog.verify.empty() && prog.keyring.empty() && prog.output_memfd.empty() && prog.crypttab.empty() && is_cout_tty())
   {
     fprintf(stderr, "stdout should not be connected to tty. Pipe output to another process to run.\n");
     return -1;
   }
 	
-  if (prog.info.host.empty())
+  if (prog.info.host.empty() && prog.batch.empty() && prog.crypttab.empty())
   {
     fprintf(stderr, "--host argument required\n");
     return -1;
@@ -223,90 +939,129 @@ int main(int, const char* argv[])
     return -1;
   }
 
-  if (prog.existing)
+  if (prog.software && prog.fmt == format::legacy)
   {
-    const expect<std::string> existing = password_prompt("Enter current password");
-    if (!existing)
-    {
-      MACER_LOG_ERROR(existing.error());
-      return -1;
-    }
-    fwrite(existing->data(), 1, existing->size(), stdout);
-    fprintf(stdout, "\n"); // tells cryptsetup about existing password
+    fprintf(stderr, "Cannot use --software with legacy format\n");
+    return -1;
   }
 
-  const usb::context ctx = usb::make_context();
-  if (!ctx)
-    return -1;
+  if (!prog.batch.empty())
+    return run_batch(prog);
+  if (!prog.crypttab.empty())
+    return run_crypttab(prog);
 
+  /* Device discovery and the exchange run on their own thread while the
+     user answers the prompts below; device prompts wait for the terminal. */
   expect<byte_slice> secret{common_error::invalid_argument};
-  while (true)
+  device_thread device{};
+  if (!prog.software)
+    device.thread = std::thread{[&secret, &prog, &device] { secret = device_secret(prog, device.stop); }};
+
+  // all output is collected, then written to stdout with one `writev`
+  byte_chain output{};
+  expect<std::string> local{common_error::invalid_argument};
   {
-    secret = usb::run(*ctx, prog.info, prog.fmt == format::legacy);
-    if (!secret)
+    /* The terminal is held until `stop` is set on failure, so the device
+       thread cannot start a prompt for an abandoned run. */
+    const terminal_lock exclusive{};
+    if (prog.existing)
     {
-      MACER_LOG_ERROR(secret.error());
-      return -1;
+      const expect<std::string> existing = prompt("Enter current password");
+      if (!existing)
+      {
+        device.stop = true;
+        MACER_LOG_ERROR(existing.error());
+        return -1;
+      }
+      static constexpr const std::uint8_t newline[] = {'\n'}; // tells cryptsetup about existing password
+      output.push_back(byte_slice{{strspan<std::uint8_t>(*existing), newline}});
     }
-    if (!secret->empty())
-      break;
 
-    fprintf(stderr, "Attach compatible device  (press any key when ready)...\n");
-    if (getchar() == EOF)
+    if (prog.password)
     {
-      fprintf(stderr, "No input available, quitting\n");
-      return -1;
+      local = prompt("Local passphrase", prog.existing);
+      if (!local)
+      {
+        device.stop = true;
+        MACER_LOG_ERROR(local.error());
+        return -1;
+      }
     }
   }
 
-  bool bip39_output = true;
-  unsigned pass_size = 64;
-  switch (prog.fmt)
+  if (prog.software)
+  {
+    secret = timing::measure(timing::phase::software, [&] { return software_secret(prog.info); });
+    if (!secret)
+    {
+      MACER_LOG_ERROR(secret.error());
+      return -1;
+    }
+  }
+  else
   {
-  default:
-  case format::legacy:
-    bip39_output = false;
-    break;
-  case format::binary:
-    bip39_output = false;
-    pass_size = 32;
-    break;
-  case format::bip39_12:
-    pass_size = 16;
-    break;
-  case format::bip39_18:
-    pass_size = 24;
-    break;
-  case format::bip39_24:
-    pass_size = 32;
-    break;
+    device.thread.join();
+    if (!secret)
+      return -1; // logged by `device_secret`
   }
 
+  const encoding enc = get_encoding(prog.fmt);
+  const bool bip39_output = enc.bip39;
+  const unsigned pass_size = enc.size;
+
   if (secret->size() < pass_size)
   {
     fprintf(stderr, "Internal Error on Password Generation\n");
     return -1;
   }
 
-  secret = secret->get_slice(0, pass_size);
-  if (bip39_output)
-    secret = bip39::encode(std::move(*secret)).value();
-  
+  if (1 < labels.size())
+    return run_derive(prog, labels, *secret, enc);
 
-  expect<std::string> local{common_error::invalid_argument};
-  if (prog.password)
+  if (labels.empty())
+    secret = secret->get_slice(0, pass_size);
+  else
   {
-    local = password_prompt("Local passphrase", prog.existing);
-    if (!local)
+    secret = timing::measure(timing::phase::hashing, [&] {
+      return trezor::expand_secret(to_span(*secret), to_span(labels[0]), pass_size);
+    });
+    if (!secret)
+    {
+      MACER_LOG_ERROR(secret.error());
+      return -1;
+    }
+  }
+  if (enc.text && !(bip39_output && !prog.verify.empty()))
+  {
+    secret = timing::measure(timing::phase::encoding, [&] { return enc.text(std::move(*secret)); });
+    if (!secret)
     {
-      MACER_LOG_ERROR(local.error());
+      MACER_LOG_ERROR(secret.error());
       return -1;
     }
   }
 
   assert(secret.has_value());
-  fwrite(secret->data(), 1, secret->size(), stdout);
+  if (!prog.verify.empty())
+    return verify(prog.verify.c_str(), *secret, bip39_output, local);
+
+  if (!prog.keyring.empty())
+    return store_key(prog, prog.keyring, *secret, local);
+
+  output.push_back(std::move(*secret));
   if (local)
-    fwrite(local->data(), 1, local->size(), stdout);
-  return 0;
+    output.push_back(byte_slice{{strspan<std::uint8_t>(*local)}});
+
+  memfd::file memfd{};
+  const int fd = open_output(prog, memfd);
+  if (fd < 0)
+    return -1;
+
+  const expect<void> written = timing::measure(timing::phase::output, [&] { return output.write(fd); });
+  if (!written)
+  {
+    MACER_LOG_ERROR(written.error());
+    return -1;
+  }
+  return close_output(prog, std::move(memfd));
 }
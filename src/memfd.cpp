@@ -0,0 +1,180 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "memfd.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include "error.hpp"
+
+extern char** environ;
+
+namespace memfd
+{
+  namespace
+  {
+    std::error_code last_error() noexcept
+    {
+      return std::error_code{errno, std::system_category()};
+    }
+
+    expect<int> send_fd(const file& out, const std::string& path)
+    {
+      sockaddr_un address{};
+      address.sun_family = AF_UNIX;
+      if (sizeof(address.sun_path) <= path.size())
+        return {common_error::invalid_argument};
+      std::memcpy(address.sun_path, path.data(), path.size());
+
+      const int sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+      if (sock < 0)
+        return last_error();
+
+      char byte = 0;
+      iovec payload{&byte, 1};
+      char control[CMSG_SPACE(sizeof(int))] = {};
+
+      msghdr message{};
+      message.msg_iov = &payload;
+      message.msg_iovlen = 1;
+      message.msg_control = control;
+      message.msg_controllen = sizeof(control);
+
+      cmsghdr* const header = CMSG_FIRSTHDR(&message);
+      header->cmsg_level = SOL_SOCKET;
+      header->cmsg_type = SCM_RIGHTS;
+      header->cmsg_len = CMSG_LEN(sizeof(int));
+      const int fd = out.get();
+      std::memcpy(CMSG_DATA(header), &fd, sizeof(fd));
+
+      std::error_code error{};
+      if (connect(sock, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+        error = last_error();
+      else
+      {
+        ssize_t sent = 0;
+        while ((sent = sendmsg(sock, &message, MSG_NOSIGNAL)) < 0 && errno == EINTR);
+        if (sent < 0)
+          error = last_error();
+      }
+      close(sock);
+      if (error)
+        return error;
+      return 0;
+    }
+
+    expect<int> run_command(const file& out, const std::string& command)
+    {
+      // everything the child needs is built before `fork`; threads may be running
+      std::string variable = "MACER_MEMFD=" + std::to_string(out.get());
+      std::vector<char*> environment{};
+      for (char** entry = environ; entry && *entry; ++entry)
+      {
+        if (std::strncmp(*entry, "MACER_MEMFD=", 12) != 0)
+          environment.push_back(*entry);
+      }
+      environment.push_back(&variable[0]);
+      environment.push_back(nullptr);
+
+      std::fflush(nullptr);
+      const pid_t child = fork();
+      if (child < 0)
+        return last_error();
+      if (child == 0)
+      {
+        if (fcntl(out.get(), F_SETFD, 0) == 0)
+          execle("/bin/sh", "sh", "-c", command.c_str(), static_cast<char*>(nullptr), environment.data());
+        _exit(127);
+      }
+
+      int status = 0;
+      while (waitpid(child, &status, 0) < 0)
+      {
+        if (errno != EINTR)
+          return last_error();
+      }
+      if (WIFEXITED(status))
+        return WEXITSTATUS(status);
+      return 128 + WTERMSIG(status);
+    }
+  } // anonymous
+
+  expect<file> file::create(const char* name)
+  {
+    file out{};
+    out.fd_ = memfd_create(name, MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (out.fd_ < 0)
+      return last_error();
+    return {std::move(out)};
+  }
+
+  file::~file() noexcept
+  {
+    if (0 <= fd_)
+      close(fd_);
+  }
+
+  file& file::operator=(file&& rhs) noexcept
+  {
+    if (this != &rhs)
+    {
+      if (0 <= fd_)
+        close(fd_);
+      fd_ = rhs.fd_;
+      rhs.fd_ = -1;
+    }
+    return *this;
+  }
+
+  expect<void> file::seal()
+  {
+    if (lseek(fd_, 0, SEEK_SET) != 0)
+      return last_error();
+    if (fcntl(fd_, F_ADD_SEALS, F_SEAL_WRITE | F_SEAL_SHRINK | F_SEAL_GROW) != 0)
+      return last_error();
+    return success();
+  }
+
+  expect<int> hand_off(file out, const std::string& target)
+  {
+    MACER_CHECK(out.seal());
+
+    static constexpr const char socket_prefix[] = "unix:";
+    if (target.compare(0, sizeof(socket_prefix) - 1, socket_prefix) == 0)
+      return send_fd(out, target.substr(sizeof(socket_prefix) - 1));
+    return run_command(out, target);
+  }
+}
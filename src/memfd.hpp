@@ -0,0 +1,77 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <string>
+
+#include "expect.hpp"
+
+//! Secrets handed to another process in a sealed memfd (`--output-memfd`).
+namespace memfd
+{
+  //! `memfd_create` file that can be sealed. Closed on destruction.
+  class file
+  {
+    int fd_;
+
+  public:
+    //! \return New empty file named `name` (for `/proc/<pid>/fd` only).
+    static expect<file> create(const char* name);
+
+    file() noexcept
+      : fd_(-1)
+    {}
+
+    file(file&& rhs) noexcept
+      : fd_(rhs.fd_)
+    {
+      rhs.fd_ = -1;
+    }
+
+    ~file() noexcept;
+
+    file& operator=(file&& rhs) noexcept;
+
+    file(const file&) = delete;
+    file& operator=(const file&) = delete;
+
+    int get() const noexcept { return fd_; }
+
+    //! Rewind and apply `F_SEAL_WRITE | F_SEAL_SHRINK | F_SEAL_GROW`.
+    expect<void> seal();
+  };
+
+  /*! Seal `out` and give it to `target`, closing macer's descriptor after.
+
+      `unix:<path>` connects to a stream socket at `path` and sends the
+      descriptor with `SCM_RIGHTS` (and one `\0` byte). Any other `target` is
+      a command run with `/bin/sh -c`, which inherits the descriptor and
+      finds its number in `MACER_MEMFD`.
+      \return Exit status of the command, 0 for a socket. */
+  expect<int> hand_off(file out, const std::string& target);
+}
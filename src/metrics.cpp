@@ -0,0 +1,225 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "metrics.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdio>
+#include <fcntl.h>
+#include <libusb-1.0/libusb.h>
+#include <unistd.h>
+
+#include "byte_chain.hpp"
+#include "byte_stream.hpp"
+#include "logger.hpp"
+
+namespace metrics
+{
+  namespace
+  {
+    registry instance{};
+
+    void write_format(byte_stream& out, const char* format, ...) __attribute__((format(printf, 2, 3)));
+    void write_format(byte_stream& out, const char* format, ...)
+    {
+      char buffer[256];
+      va_list args;
+      va_start(args, format);
+      const int length = std::vsnprintf(buffer, sizeof(buffer), format, args);
+      va_end(args);
+      if (0 < length)
+        out.write(buffer, std::min(std::size_t(length), sizeof(buffer) - 1));
+    }
+
+    void write_header(byte_stream& out, const char* name, const char* type, const char* help)
+    {
+      write_format(out, "# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+    }
+
+    void write_counter(byte_stream& out, const char* name, const char* help, const counter& value)
+    {
+      write_header(out, name, "counter", help);
+      write_format(out, "%s %" PRIu64 "\n", name, value.get());
+    }
+
+    //! `labels` is empty or `key="value",` (trailing comma included).
+    void write_histogram(byte_stream& out, const char* name, const char* labels, const histogram& value)
+    {
+      std::uint64_t total = 0;
+      for (std::size_t i = 0; i < histogram::buckets; ++i)
+      {
+        total += value.count(i);
+        write_format(out, "%s_bucket{%sle=\"%g\"} %" PRIu64 "\n", name, labels, histogram::bounds[i], total);
+      }
+      total += value.count(histogram::buckets);
+      write_format(out, "%s_bucket{%sle=\"+Inf\"} %" PRIu64 "\n", name, labels, total);
+
+      std::string plain{labels};
+      if (!plain.empty())
+      {
+        plain.pop_back();
+        plain = "{" + plain + "}";
+      }
+      write_format(out, "%s_sum%s %.9f\n", name, plain.c_str(), double(value.sum_ns()) / 1e9);
+      write_format(out, "%s_count%s %" PRIu64 "\n", name, plain.c_str(), total);
+    }
+
+    byte_slice serialize(const registry& source)
+    {
+      byte_stream out{};
+      write_counter(out, "macer_usb_reports_sent_total", "64-byte reports written to the device.", source.reports_sent);
+      write_counter(out, "macer_usb_reports_received_total", "64-byte reports read from the device.", source.reports_received);
+      write_counter(out, "macer_usb_bytes_sent_total", "Bytes written to the device.", source.bytes_sent);
+      write_counter(out, "macer_usb_bytes_received_total", "Bytes read from the device.", source.bytes_received);
+
+      write_header(out, "macer_usb_errors_total", "counter", "Failed libusb calls by error.");
+      for (std::size_t i = 1; i < registry::usb_errors; ++i)
+      {
+        const int rc = (i + 1 == registry::usb_errors) ? int(LIBUSB_ERROR_OTHER) : -int(i);
+        write_format(out, "macer_usb_errors_total{error=\"%s\"} %" PRIu64 "\n", libusb_error_name(rc), source.transfer_errors[i].get());
+      }
+
+      write_counter(out, "macer_messages_received_total", "Protocol messages read from the device.", source.messages_received);
+      write_counter(out, "macer_message_errors_total", "Messages with invalid framing or an unsupported id.", source.message_errors);
+
+      write_header(out, "macer_runs_total", "counter", "Completed device sessions by result.");
+      write_format(out, "macer_runs_total{result=\"success\"} %" PRIu64 "\n", source.runs_succeeded.get());
+      write_format(out, "macer_runs_total{result=\"failure\"} %" PRIu64 "\n", source.runs_failed.get());
+
+      write_header(out, "macer_run_seconds", "histogram", "Device session duration, initialize to secret.");
+      write_histogram(out, "macer_run_seconds", "", source.run_seconds);
+
+      write_header(out, "macer_button_wait_seconds", "histogram", "Time from button_ack until the device responds.");
+      write_histogram(out, "macer_button_wait_seconds", "", source.button_seconds);
+
+      write_header(out, "macer_request_seconds", "histogram", "Round trip from sending a request until its response starts, by message id.");
+      for (std::size_t id = 0; id < registry::max_message_id; ++id)
+      {
+        const histogram& value = source.request_seconds[id];
+        std::uint64_t total = 0;
+        for (std::size_t i = 0; i <= histogram::buckets; ++i)
+          total += value.count(i);
+        if (!total)
+          continue;
+
+        char labels[32];
+        std::snprintf(labels, sizeof(labels), "id=\"%zu\",", id);
+        write_histogram(out, "macer_request_seconds", labels, value);
+      }
+      return byte_slice{std::move(out)};
+    }
+  } // anonymous
+
+  const double histogram::bounds[histogram::buckets] =
+    {0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30};
+
+  histogram::histogram() noexcept
+    : counts_(), sum_(0)
+  {
+    for (std::atomic<std::uint64_t>& count : counts_)
+      count.store(0, std::memory_order_relaxed);
+  }
+
+  void histogram::observe(const std::chrono::nanoseconds elapsed) noexcept
+  {
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    std::size_t i = 0;
+    while (i < buckets && bounds[i] < seconds)
+      ++i;
+    counts_[i].fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(std::uint64_t(elapsed.count()), std::memory_order_relaxed);
+  }
+
+  registry& get() noexcept
+  {
+    return instance;
+  }
+
+  void usb_error(const int rc) noexcept
+  {
+    std::size_t i = registry::usb_errors - 1;
+    if (rc <= 0 && -rc < int(registry::usb_errors - 1))
+      i = std::size_t(-rc);
+    instance.transfer_errors[i].add();
+  }
+
+  expect<void> write(const std::string& path)
+  {
+    const std::string temporary = path + ".tmp";
+    const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+      return std::error_code{errno, std::system_category()};
+
+    byte_chain chain{};
+    chain.push_back(serialize(instance));
+    const expect<void> written = chain.write(fd);
+    if (close(fd) != 0 && written)
+      return std::error_code{errno, std::system_category()};
+    if (!written)
+      return written;
+
+    if (std::rename(temporary.c_str(), path.c_str()) != 0)
+      return std::error_code{errno, std::system_category()};
+    return success();
+  }
+
+  exporter::exporter(std::string path, const std::chrono::seconds interval)
+    : path_(std::move(path)), interval_(interval), lock_(), wake_(), stop_(false), thread_()
+  {
+    if (!path_.empty())
+      thread_ = std::thread{&exporter::run, this};
+  }
+
+  exporter::~exporter() noexcept
+  {
+    if (!thread_.joinable())
+      return;
+    {
+      const std::lock_guard<std::mutex> guard{lock_};
+      stop_ = true;
+    }
+    wake_.notify_all();
+    thread_.join();
+  }
+
+  void exporter::run()
+  {
+    std::unique_lock<std::mutex> guard{lock_};
+    for (;;)
+    {
+      const bool stopping = wake_.wait_for(guard, interval_, [this] { return stop_; });
+      const expect<void> written = write(path_);
+      if (!written)
+        MACER_LOG_ERROR(written.error(), "--metrics-file");
+      if (stopping)
+        return;
+    }
+  }
+}
@@ -0,0 +1,148 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "expect.hpp"
+
+//! Process-wide counters and histograms, exported as a Prometheus textfile.
+namespace metrics
+{
+  //! \brief Monotonic count; updates are single relaxed atomic adds.
+  class counter
+  {
+    std::atomic<std::uint64_t> value_;
+
+  public:
+    constexpr counter() noexcept
+      : value_(0)
+    {}
+
+    void add(const std::uint64_t amount = 1) noexcept
+    {
+      value_.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    std::uint64_t get() const noexcept
+    {
+      return value_.load(std::memory_order_relaxed);
+    }
+  };
+
+  /*! \brief Durations counted into fixed buckets (0.5 ms to 30 s, shared by
+      every histogram). Updates are two relaxed atomic adds. */
+  class histogram
+  {
+  public:
+    static constexpr const std::size_t buckets = 15;
+
+    //! Upper bound of each bucket, in seconds.
+    static const double bounds[buckets];
+
+  private:
+    std::atomic<std::uint64_t> counts_[buckets + 1]; //!< `[buckets]` is `+Inf`
+    std::atomic<std::uint64_t> sum_; //!< Nanoseconds
+
+  public:
+    histogram() noexcept;
+
+    void observe(std::chrono::nanoseconds elapsed) noexcept;
+
+    //! \return Observations in bucket `i` (not cumulative).
+    std::uint64_t count(std::size_t i) const noexcept
+    {
+      return counts_[i].load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t sum_ns() const noexcept
+    {
+      return sum_.load(std::memory_order_relaxed);
+    }
+  };
+
+  //! Every metric macer exports. See `write` for names.
+  struct registry
+  {
+    //! Request message ids are below this; larger ids are not tracked.
+    static constexpr const std::size_t max_message_id = 64;
+    //! `usb::error` values `-1` to `-12` at `[1]` to `[12]`; others at `[13]`.
+    static constexpr const std::size_t usb_errors = 14;
+
+    counter reports_sent;
+    counter reports_received;
+    counter bytes_sent;
+    counter bytes_received;
+    counter transfer_errors[usb_errors];
+    counter messages_received;
+    counter message_errors;
+    counter runs_succeeded;
+    counter runs_failed;
+    histogram run_seconds;
+    histogram button_seconds; //!< `button_ack` until the device responds
+    histogram request_seconds[max_message_id]; //!< By request message id
+  };
+
+  //! \return The process-wide registry.
+  registry& get() noexcept;
+
+  //! Count a failed libusb call with return code `rc`.
+  void usb_error(int rc) noexcept;
+
+  //! Write every metric to `path` atomically (temporary file and `rename`).
+  expect<void> write(const std::string& path);
+
+  /*! \brief Thread that `write`s the registry every `interval`, and once
+      more on destruction, for the node_exporter textfile collector. An
+      empty `path` exports nothing. */
+  class exporter
+  {
+    const std::string path_;
+    const std::chrono::seconds interval_;
+    std::mutex lock_;
+    std::condition_variable wake_;
+    bool stop_;
+    std::thread thread_;
+
+    void run();
+
+  public:
+    exporter(std::string path, std::chrono::seconds interval);
+    ~exporter() noexcept;
+
+    exporter(const exporter&) = delete;
+    exporter& operator=(const exporter&) = delete;
+  };
+}
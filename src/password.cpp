@@ -40,6 +40,8 @@ namespace
 {
   constexpr const std::size_t max_password_size = 1000;
 
+  std::recursive_mutex terminal{};
+
   bool is_tty(FILE* file) noexcept
   {
     return 0 != isatty(fileno(file));
@@ -88,6 +90,10 @@ namespace
   }
 }
 
+terminal_lock::terminal_lock()
+  : lock_(terminal)
+{}
+
 bool is_cout_tty() noexcept
 {
   return is_tty(stdout);
@@ -95,6 +101,7 @@ bool is_cout_tty() noexcept
 
 expect<std::string> password_prompt(const char* message, const bool confirm)
 {
+  const terminal_lock exclusive{};
   expect<std::string> secret = do_password(message);
   if (secret && confirm && secret != do_password("Confirm"))
     return {common_error::invalid_argument};
@@ -1,7 +1,23 @@
 #pragma once
 
+#include <mutex>
 #include <string>
 #include "expect.hpp"
 
+/*! \brief Exclusive use of the terminal (stdin, and prompts on stderr).
+
+    The device exchange runs on its own thread while the user answers local
+    prompts, so device-triggered prompts and notices hold this across their
+    output and input to keep the two from interleaving. Recursive, so a
+    holder can call `password_prompt`. */
+class terminal_lock
+{
+  std::unique_lock<std::recursive_mutex> lock_;
+public:
+  terminal_lock();
+};
+
 bool is_cout_tty() noexcept;
+
+//! Takes a `terminal_lock` for both the prompt and the `confirm` prompt.
 expect<std::string> password_prompt(const char* message, bool confirm = false);
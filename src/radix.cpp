@@ -0,0 +1,208 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "radix.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string.h>
+#include <vector>
+
+#include "error.hpp"
+
+namespace radix
+{
+  namespace
+  {
+    constexpr const char base58_alphabet[] =
+      "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+    constexpr const char base32_alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+    constexpr const char z85_alphabet[] =
+      "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ.-:+=^!/*?&<>()[]{}@%$#";
+    constexpr const char hex_alphabet[] = "0123456789abcdef";
+
+    /*! Five base58 digits per limb, so every multiply-add and division in
+        the conversion fits in 64 bits (`limb * 2^32 + carry < 2^63`). */
+    constexpr const std::uint32_t limb_digits = 5;
+    constexpr const std::uint64_t limb_base = 58ull * 58 * 58 * 58 * 58;
+
+    //! Limbs kept on the stack; enough for 145 input bytes.
+    constexpr const std::size_t stack_limbs = 40;
+
+    byte_buffer allocate(const std::size_t size)
+    {
+      byte_buffer out = byte_buffer_resize(nullptr, size);
+      if (!out && size)
+        throw std::bad_alloc{};
+      return out;
+    }
+  } // anonymous
+
+  expect<byte_slice> base58(const byte_slice in)
+  {
+    std::size_t zeroes = 0;
+    while (zeroes < in.size() && in.data()[zeroes] == 0)
+      ++zeroes;
+
+    const std::uint8_t* current = in.data() + zeroes;
+    const std::uint8_t* const end = in.data() + in.size();
+
+    // log2(58^5) > 29, so `8n / 29 + 1` limbs always hold `n` bytes
+    const std::size_t max_limbs = (std::size_t(end - current) * 8) / 29 + 1;
+    std::uint32_t stack[stack_limbs];
+    std::vector<std::uint32_t> heap;
+    std::uint32_t* limbs = stack;
+    if (stack_limbs < max_limbs)
+    {
+      heap.resize(max_limbs);
+      limbs = heap.data();
+    }
+
+    // Horner's method, 32 input bits at a time, into base 58^5 limbs
+    std::size_t used = 0;
+    std::size_t group = std::size_t(end - current) % 4;
+    if (!group)
+      group = 4;
+    while (current != end)
+    {
+      std::uint64_t carry = 0;
+      for (std::size_t i = 0; i < group; ++i)
+        carry = (carry << 8) | *current++;
+
+      const unsigned shift = unsigned(group * 8);
+      for (std::size_t i = 0; i < used; ++i)
+      {
+        const std::uint64_t value = (std::uint64_t(limbs[i]) << shift) + carry;
+        limbs[i] = std::uint32_t(value % limb_base);
+        carry = value / limb_base;
+      }
+      while (carry)
+      {
+        limbs[used++] = std::uint32_t(carry % limb_base);
+        carry /= limb_base;
+      }
+      group = 4;
+    }
+
+    std::size_t top_digits = 0;
+    if (used)
+    {
+      for (std::uint32_t top = limbs[used - 1]; top; top /= 58)
+        ++top_digits;
+    }
+
+    const std::size_t digits = used ? top_digits + (used - 1) * limb_digits : 0;
+    const std::size_t total = zeroes + digits;
+    byte_buffer buffer = allocate(total);
+
+    std::uint8_t* out = buffer.get();
+    std::memset(out, '1', zeroes);
+    out += total;
+    for (std::size_t i = 0; i < used; ++i)
+    {
+      std::uint32_t limb = limbs[i];
+      const std::size_t count = (i + 1 == used) ? top_digits : limb_digits;
+      for (std::size_t j = 0; j < count; ++j)
+      {
+        *--out = base58_alphabet[limb % 58];
+        limb /= 58;
+      }
+    }
+
+    explicit_bzero(limbs, used * sizeof(limbs[0]));
+    return byte_slice{std::move(buffer), total};
+  }
+
+  expect<byte_slice> base32(const byte_slice in)
+  {
+    static constexpr const std::size_t tail_chars[5] = {0, 2, 4, 5, 7};
+
+    const std::size_t total = ((in.size() + 4) / 5) * 8;
+    byte_buffer buffer = allocate(total);
+
+    const std::uint8_t* current = in.data();
+    const std::uint8_t* const end = current + in.size();
+    std::uint8_t* out = buffer.get();
+    while (current != end)
+    {
+      const std::size_t count = std::min(std::size_t(end - current), std::size_t(5));
+      std::uint64_t bits = 0;
+      for (std::size_t i = 0; i < 5; ++i)
+        bits = (bits << 8) | (i < count ? current[i] : 0);
+      current += count;
+
+      const std::size_t chars = count == 5 ? 8 : tail_chars[count];
+      for (std::size_t i = 0; i < 8; ++i)
+        out[i] = i < chars ? base32_alphabet[(bits >> (35 - i * 5)) & 0x1f] : '=';
+      out += 8;
+    }
+
+    return byte_slice{std::move(buffer), total};
+  }
+
+  expect<byte_slice> z85(const byte_slice in)
+  {
+    if (in.size() % 4)
+      return {common_error::invalid_argument};
+
+    const std::size_t total = (in.size() / 4) * 5;
+    byte_buffer buffer = allocate(total);
+
+    const std::uint8_t* current = in.data();
+    std::uint8_t* out = buffer.get();
+    for (std::size_t i = 0; i < in.size() / 4; ++i, current += 4, out += 5)
+    {
+      std::uint32_t value =
+        (std::uint32_t(current[0]) << 24) | (std::uint32_t(current[1]) << 16) |
+        (std::uint32_t(current[2]) << 8) | current[3];
+      for (std::size_t j = 5; j; --j)
+      {
+        out[j - 1] = z85_alphabet[value % 85];
+        value /= 85;
+      }
+    }
+
+    return byte_slice{std::move(buffer), total};
+  }
+
+  expect<byte_slice> hex(const byte_slice in)
+  {
+    const std::size_t total = in.size() * 2;
+    byte_buffer buffer = allocate(total);
+
+    std::uint8_t* out = buffer.get();
+    for (const std::uint8_t byte : in)
+    {
+      *out++ = hex_alphabet[byte >> 4];
+      *out++ = hex_alphabet[byte & 0xf];
+    }
+
+    return byte_slice{std::move(buffer), total};
+  }
+}
@@ -0,0 +1,161 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+thread_pool::thread_pool(std::size_t workers)
+  : queues_(),
+    threads_(),
+    lock_(),
+    start_(),
+    finished_(),
+    job_(nullptr),
+    generation_(0),
+    active_(0),
+    stop_(false)
+{
+  if (!workers)
+    workers = std::max(1u, std::thread::hardware_concurrency());
+
+  queues_.reset(new queue[workers]);
+  threads_.reserve(workers - 1);
+  try
+  {
+    for (std::size_t i = 1; i < workers; ++i)
+      threads_.emplace_back(&thread_pool::thread_main, this, i);
+  }
+  catch (...)
+  {
+    shutdown();
+    throw;
+  }
+}
+
+thread_pool::~thread_pool() noexcept
+{
+  shutdown();
+}
+
+void thread_pool::shutdown() noexcept
+{
+  {
+    const std::lock_guard<std::mutex> guard{lock_};
+    stop_ = true;
+  }
+  start_.notify_all();
+  for (std::thread& thread : threads_)
+  {
+    if (thread.joinable())
+      thread.join();
+  }
+  threads_.clear();
+}
+
+bool thread_pool::pop(const std::size_t worker, chunk& out)
+{
+  queue& own = queues_[worker];
+  const std::lock_guard<std::mutex> guard{own.lock};
+  if (own.chunks.empty())
+    return false;
+  out = own.chunks.front();
+  own.chunks.pop_front();
+  return true;
+}
+
+bool thread_pool::steal(const std::size_t worker, chunk& out)
+{
+  // start with the next worker, so thieves spread over the victims
+  for (std::size_t i = 1; i < size(); ++i)
+  {
+    queue& victim = queues_[(worker + i) % size()];
+    const std::lock_guard<std::mutex> guard{victim.lock};
+    if (!victim.chunks.empty())
+    {
+      out = victim.chunks.back();
+      victim.chunks.pop_back();
+      return true;
+    }
+  }
+  return false;
+}
+
+void thread_pool::work(const std::size_t worker)
+{
+  // every chunk is queued before workers start, so empty deques mean done
+  chunk next{};
+  while (pop(worker, next) || steal(worker, next))
+    (*job_)(worker, next.begin, next.end);
+}
+
+void thread_pool::thread_main(const std::size_t worker)
+{
+  std::size_t seen = 0;
+  for (;;)
+  {
+    {
+      std::unique_lock<std::mutex> guard{lock_};
+      start_.wait(guard, [this, seen] () { return stop_ || generation_ != seen; });
+      if (stop_)
+        return;
+      seen = generation_;
+    }
+
+    work(worker);
+
+    const std::lock_guard<std::mutex> guard{lock_};
+    if (--active_ == 0)
+      finished_.notify_all();
+  }
+}
+
+void thread_pool::for_each(const std::size_t count, std::size_t grain, const job& fn)
+{
+  grain = std::max(std::size_t(1), grain);
+  std::size_t next = 0;
+  for (std::size_t begin = 0; begin < count; begin += grain, ++next)
+  {
+    queue& target = queues_[next % size()];
+    const std::lock_guard<std::mutex> guard{target.lock};
+    target.chunks.push_back({begin, begin + std::min(grain, count - begin)});
+  }
+
+  {
+    const std::lock_guard<std::mutex> guard{lock_};
+    job_ = std::addressof(fn);
+    active_ = threads_.size();
+    ++generation_;
+  }
+  start_.notify_all();
+
+  work(0);
+
+  std::unique_lock<std::mutex> guard{lock_};
+  finished_.wait(guard, [this] () { return active_ == 0; });
+  job_ = nullptr;
+}
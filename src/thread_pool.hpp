@@ -0,0 +1,101 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*! \brief Fixed set of worker threads with one work deque per worker.
+
+    `for_each` splits an index range into chunks and deals them round-robin
+    onto the worker deques. Each worker drains its own deque from the front
+    (lowest index first), and an idle worker steals from the back of another
+    deque, so uneven chunks still keep every core busy while completion
+    order stays close to index order (small reorder window downstream).
+
+    The deques are mutex protected; a chunk is expected to cost far more
+    (tens of microseconds and up) than an uncontended lock. */
+class thread_pool
+{
+public:
+  //! Called with the worker number and a chunk `[begin, end)`. Must not throw.
+  using job = std::function<void(std::size_t worker, std::size_t begin, std::size_t end)>;
+
+private:
+  struct chunk
+  {
+    std::size_t begin;
+    std::size_t end;
+  };
+
+  struct queue
+  {
+    std::mutex lock;
+    std::deque<chunk> chunks;
+  };
+
+  std::unique_ptr<queue[]> queues_; //!< One per worker, `[0]` is the caller
+  std::vector<std::thread> threads_;
+  std::mutex lock_;
+  std::condition_variable start_;
+  std::condition_variable finished_;
+  const job* job_;
+  std::size_t generation_;
+  std::size_t active_; //!< Threads still working on `generation_`
+  bool stop_;
+
+  bool pop(std::size_t worker, chunk& out);
+  bool steal(std::size_t worker, chunk& out);
+  void work(std::size_t worker);
+  void thread_main(std::size_t worker);
+  void shutdown() noexcept;
+
+public:
+  /*! Start `workers - 1` threads; the thread calling `for_each` is the
+      last worker. `workers == 0` uses one per hardware thread.
+      \throw std::system_error if a thread cannot be started. */
+  explicit thread_pool(std::size_t workers = 0);
+
+  thread_pool(const thread_pool&) = delete;
+  ~thread_pool() noexcept;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  //! \return Number of workers, including the caller of `for_each`.
+  std::size_t size() const noexcept { return threads_.size() + 1; }
+
+  /*! Call `fn` on chunks of at most `grain` indexes covering `[0, count)`,
+      and return when all have completed. Not reentrant; one caller at a
+      time. */
+  void for_each(std::size_t count, std::size_t grain, const job& fn);
+};
@@ -0,0 +1,148 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "timing.hpp"
+
+#include <atomic>
+#include <cstddef>
+
+#include "trace.hpp"
+
+namespace timing
+{
+  namespace
+  {
+    using clock = std::chrono::steady_clock;
+
+    constexpr const char* names[] =
+    {
+      "arguments",
+      "usb context",
+      "enumerate",
+      "open/claim",
+      "initialize",
+      "get_public_key",
+      "get_ecdh_session",
+      "sign_identity",
+      "software",
+      "framing",
+      "protobuf",
+      "hashing",
+      "encoding",
+      "output",
+      "pin",
+      "passphrase",
+      "button",
+      "prompt"
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == std::size_t(phase::count), "missing phase name");
+
+    const clock::time_point started = clock::now(); //!< Static init, before `main`
+    std::atomic<clock::rep> totals[std::size_t(phase::count)] = {};
+    thread_local scope* current = nullptr;
+    bool enabled = false;
+
+    double to_ms(const clock::duration elapsed) noexcept
+    {
+      return std::chrono::duration<double, std::milli>(elapsed).count();
+    }
+
+    void add(const phase which, const clock::duration elapsed) noexcept
+    {
+      totals[std::size_t(which)].fetch_add(elapsed.count(), std::memory_order_relaxed);
+    }
+  } // anonymous
+
+  scope::scope(const phase which) noexcept
+    : parent_(current),
+      resumed_(clock::now()),
+      traced_(trace::enabled() ? trace::now() : 0),
+      which_(which)
+  {
+    if (parent_)
+      add(parent_->which_, resumed_ - parent_->resumed_);
+    current = this;
+  }
+
+  scope::~scope() noexcept
+  {
+    const clock::time_point now = clock::now();
+    add(which_, now - resumed_);
+    current = parent_;
+    if (parent_)
+      parent_->resumed_ = now;
+    if (traced_)
+      trace::record(names[std::size_t(which_)], is_human(which_) ? "human" : "phase", traced_, trace::now());
+  }
+
+  phase active() noexcept
+  {
+    return current ? current->which_ : phase::count;
+  }
+
+  const char* name(const phase which) noexcept
+  {
+    return which < phase::count ? names[std::size_t(which)] : "untracked";
+  }
+
+  void enable() noexcept
+  {
+    enabled = true;
+  }
+
+  void report(std::FILE* out)
+  {
+    if (!enabled)
+      return;
+
+    clock::duration machine{};
+    clock::duration human{};
+    std::fprintf(out, "Timing (ms):\n");
+    for (std::size_t i = 0; i < std::size_t(phase::count); ++i)
+    {
+      const clock::duration total{totals[i].load(std::memory_order_relaxed)};
+      if (total == clock::duration::zero())
+        continue;
+      std::fprintf(out, "  %-18s %10.3f%s\n", names[i], to_ms(total), is_human(phase(i)) ? "  (human)" : "");
+      if (is_human(phase(i)))
+        human += total;
+      else
+        machine += total;
+    }
+
+    // the device thread runs phases while the main thread prompts
+    const clock::duration wall = clock::now() - started;
+    const clock::duration tracked = machine + human;
+    const clock::duration overlap = wall < tracked ? tracked - wall : clock::duration::zero();
+    std::fprintf(out, "  %-18s %10.3f\n", "untracked", to_ms(wall - tracked + overlap));
+    if (overlap != clock::duration::zero())
+      std::fprintf(out, "  %-18s %10.3f\n", "overlapped", to_ms(overlap));
+    std::fprintf(out, "  %-18s %10.3f\n", "machine total", to_ms(wall - human + overlap));
+    std::fprintf(out, "  %-18s %10.3f\n", "human total", to_ms(human));
+    std::fprintf(out, "  %-18s %10.3f\n", "wall total", to_ms(wall));
+  }
+}
@@ -0,0 +1,118 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+//! Wall clock breakdown of a run by phase (`--trace-timing`).
+namespace timing
+{
+  //! Phases from `pin` onward are time spent waiting on a person.
+  enum class phase : std::uint8_t
+  {
+    arguments = 0,
+    context,       //!< `usb::make_context`
+    enumerate,     //!< USB device list and descriptors
+    open,          //!< `libusb_open` through interface claim
+    initialize,
+    public_key,    //!< `get_public_key` round trip
+    ecdh_session,  //!< `get_ecdh_session` round trip
+    sign_identity, //!< legacy `sign_identity` round trip
+    software,      //!< `--software` derivation
+    framing,       //!< 64-byte report packing, and reports after the first
+    protobuf,      //!< Message encode and decode
+    hashing,
+    encoding,
+    output,
+    pin,
+    passphrase,
+    button,
+    prompt,        //!< Mnemonic, existing or local password, device attach
+    count
+  };
+
+  constexpr bool is_human(const phase which) noexcept
+  {
+    return phase::pin <= which;
+  }
+
+  /*! \brief Adds monotonic time until destruction to a phase.
+
+      Scopes nest; time is charged only to the innermost scope, so a PIN
+      prompt inside a `get_public_key` round trip is counted as human wait
+      and not as device time. Each scope is also a `trace` span (including
+      nested time) when tracing is enabled. Scopes must be created and
+      destroyed on one thread, in stack order. Nesting is per thread and
+      totals are shared, so phases on different threads can overlap in wall
+      time. */
+  class scope
+  {
+    scope* parent_;
+    std::chrono::steady_clock::time_point resumed_;
+    const std::uint64_t traced_; //!< `trace::now()` at start, 0 if not tracing
+    const phase which_;
+
+    friend phase active() noexcept;
+
+  public:
+    explicit scope(phase which) noexcept;
+    ~scope() noexcept;
+
+    scope(const scope&) = delete;
+    scope& operator=(const scope&) = delete;
+  };
+
+  //! \return Innermost phase of the calling thread, `phase::count` if none.
+  phase active() noexcept;
+
+  //! \return `f()`, with the time it took added to `which`.
+  template<typename F>
+  auto measure(const phase which, F f) -> decltype(f())
+  {
+    const scope timer{which};
+    return f();
+  }
+
+  //! Print a breakdown when `report` is called.
+  void enable() noexcept;
+
+  //! \return Display name of `which`.
+  const char* name(phase which) noexcept;
+
+  //! Write per-phase totals, and machine vs human totals, to `out` if enabled.
+  void report(std::FILE* out);
+
+  //! Calls `report` on destruction, covering every return path of `main`.
+  struct report_on_exit
+  {
+    std::FILE* out;
+    ~report_on_exit() { report(out); }
+  };
+}
@@ -0,0 +1,189 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <unistd.h>
+
+#include "byte_chain.hpp"
+#include "byte_stream.hpp"
+#include "logger.hpp"
+
+namespace trace
+{
+  namespace
+  {
+    using clock = std::chrono::steady_clock;
+
+    struct event
+    {
+      const char* name;
+      const char* category;
+      const char* arg;
+      std::uint64_t value;
+      std::uint64_t begin;
+      std::uint64_t end;
+      std::uint32_t thread;
+    };
+
+    const clock::time_point started = clock::now(); //!< Static init, before `main`
+    std::unique_ptr<event[]> events;
+    std::size_t capacity = 0;
+    std::atomic<std::size_t> next{0};
+    std::atomic<bool> active{false};
+    std::atomic<std::uint32_t> next_thread{0};
+
+    std::uint32_t thread_id() noexcept
+    {
+      static thread_local const std::uint32_t id = next_thread.fetch_add(1, std::memory_order_relaxed);
+      return id;
+    }
+
+    template<std::size_t N>
+    void write_literal(byte_stream& out, const char (&text)[N])
+    {
+      out.write(text, N - 1);
+    }
+
+    //! Append `ns` as microseconds with three decimals.
+    void write_us(byte_stream& out, const std::uint64_t ns)
+    {
+      char buffer[32];
+      const int length = std::snprintf(buffer, sizeof(buffer), "%" PRIu64 ".%03u", ns / 1000, unsigned(ns % 1000));
+      out.write(buffer, std::size_t(length));
+    }
+
+    void write_number(byte_stream& out, const std::uint64_t value)
+    {
+      char buffer[24];
+      const int length = std::snprintf(buffer, sizeof(buffer), "%" PRIu64, value);
+      out.write(buffer, std::size_t(length));
+    }
+
+    void write_string(byte_stream& out, const char* value)
+    {
+      out.put('"');
+      out.write(value, std::strlen(value));
+      out.put('"');
+    }
+  } // anonymous
+
+  void enable(const std::size_t count)
+  {
+    events.reset(new event[count]);
+    capacity = count;
+    next.store(0, std::memory_order_relaxed);
+    active.store(true, std::memory_order_release);
+  }
+
+  bool enabled() noexcept
+  {
+    return active.load(std::memory_order_relaxed);
+  }
+
+  std::uint64_t now() noexcept
+  {
+    // `+ 1` so a valid timestamp is never zero (see `span`)
+    return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - started).count()) + 1;
+  }
+
+  void record(const char* name, const char* category, const std::uint64_t begin, const std::uint64_t end, const char* arg, const std::uint64_t value) noexcept
+  {
+    if (!active.load(std::memory_order_acquire))
+      return;
+
+    const std::size_t slot = next.fetch_add(1, std::memory_order_relaxed);
+    if (capacity <= slot)
+      return;
+    events[slot] = event{name, category, arg, value, begin, end, thread_id()};
+  }
+
+  expect<void> write(const char* path)
+  {
+    const std::size_t total = next.load(std::memory_order_acquire);
+    const std::size_t count = std::min(total, capacity);
+
+    byte_stream out{};
+    write_literal(out, "{\"traceEvents\":[");
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const event& current = events[i];
+      if (i)
+        out.put(',');
+      write_literal(out, "\n{\"name\":");
+      write_string(out, current.name);
+      write_literal(out, ",\"cat\":");
+      write_string(out, current.category);
+      write_literal(out, ",\"ph\":\"X\",\"pid\":1,\"tid\":");
+      write_number(out, current.thread);
+      write_literal(out, ",\"ts\":");
+      write_us(out, current.begin);
+      write_literal(out, ",\"dur\":");
+      write_us(out, current.end - current.begin);
+      if (current.arg)
+      {
+        write_literal(out, ",\"args\":{");
+        write_string(out, current.arg);
+        out.put(':');
+        write_number(out, current.value);
+        out.put('}');
+      }
+      out.put('}');
+    }
+    write_literal(out, "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped\":");
+    write_number(out, total - count);
+    write_literal(out, "}}\n");
+
+    const int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0)
+      return std::error_code{errno, std::system_category()};
+
+    byte_chain chain{};
+    chain.push_back(byte_slice{std::move(out)});
+    const expect<void> written = chain.write(fd);
+    close(fd);
+    return written;
+  }
+
+  write_on_exit::~write_on_exit()
+  {
+    if (path.empty())
+      return;
+    const expect<void> written = write(path.c_str());
+    if (!written)
+      MACER_LOG_ERROR(written.error(), "--trace-file");
+  }
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "expect.hpp"
+
+//! In-memory event timeline, written as Chrome trace JSON (`--trace-file`).
+namespace trace
+{
+  //! Events kept by default; later events are counted and dropped.
+  constexpr const std::size_t default_capacity = 1 << 16;
+
+  /*! Allocate space for `capacity` events and start recording. Must be
+      called before any other thread records. */
+  void enable(std::size_t capacity = default_capacity);
+
+  //! \return True if events are being recorded.
+  bool enabled() noexcept;
+
+  //! \return Monotonic nanoseconds since process start.
+  std::uint64_t now() noexcept;
+
+  /*! Store a complete event `[begin, end)`. Lock-free: a slot is claimed
+      with one atomic increment and written only by the calling thread.
+      `name`, `category` and `arg` must be string literals (no JSON
+      escaping is done). No-op when not `enabled()`. */
+  void record(const char* name, const char* category, std::uint64_t begin, std::uint64_t end, const char* arg = nullptr, std::uint64_t value = 0) noexcept;
+
+  //! \brief `record`s the lifetime of the object.
+  class span
+  {
+    const char* const name_;
+    const char* const category_;
+    const char* const arg_;
+    const std::uint64_t value_;
+    const std::uint64_t begin_;
+
+  public:
+    span(const char* name, const char* category, const char* arg = nullptr, std::uint64_t value = 0) noexcept
+      : name_(name), category_(category), arg_(arg), value_(value), begin_(enabled() ? now() : 0)
+    {}
+
+    ~span() noexcept
+    {
+      if (begin_)
+        record(name_, category_, begin_, now(), arg_, value_);
+    }
+
+    span(const span&) = delete;
+    span& operator=(const span&) = delete;
+  };
+
+  /*! Write all recorded events to `path` as Chrome trace JSON (viewable in
+      `chrome://tracing` or Perfetto). Call after recording threads finish. */
+  expect<void> write(const char* path);
+
+  //! Calls `write` on destruction when `path` is not empty; errors are logged.
+  struct write_on_exit
+  {
+    const std::string& path;
+    ~write_on_exit();
+  };
+}
@@ -41,6 +41,8 @@ namespace trezor
       return "Invalid byte encoding over USB";
     case error::unsupported_message:
       return "Unsupported Trezor message";
+    case error::timed_out:
+      return "Timed out waiting for Trezor";
     default:
       break;
     }
@@ -37,7 +37,8 @@ namespace trezor
     success = 0, // per expect<T> requirements
     device_failure,
     invalid_encoding,
-    unsupported_message
+    unsupported_message,
+    timed_out
   };
 
   //! \return Static string describing error `value`.
@@ -0,0 +1,105 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "trezor/framing.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "byte_chain.hpp"
+#include "byte_stream.hpp"
+#include "trezor/error.hpp"
+
+namespace trezor
+{
+  namespace framing
+  {
+    namespace
+    {
+      void pack_payload(report& dest, const std::size_t offset, byte_chain& payload) noexcept
+      {
+        const std::size_t next = payload.copy_prefix({dest + offset, report_size - offset});
+        std::memset(dest + offset + next, 0, report_size - offset - next);
+        payload.remove_prefix(next);
+      }
+    } // anonymous
+
+    void pack_first(report& dest, const message_id id, byte_chain& payload) noexcept
+    {
+      const std::uint32_t size = payload.size();
+      dest[0] = '?';
+      dest[1] = '#';
+      dest[2] = '#';
+
+      dest[3] = std::uint16_t(id) >> 8;
+      dest[4] = std::uint16_t(id) & 0xFF;
+
+      dest[5] = (size >> 24) & 0xFF;
+      dest[6] = (size >> 16) & 0xFF;
+      dest[7] = (size >> 8) & 0xFF;
+      dest[8] = size & 0xFF;
+
+      pack_payload(dest, 9, payload);
+    }
+
+    void pack_next(report& dest, byte_chain& payload) noexcept
+    {
+      dest[0] = '?';
+      pack_payload(dest, 1, payload);
+    }
+
+    expect<std::uint16_t> unpack_first(const report& source, byte_stream& dest, std::uint32_t& remaining)
+    {
+      if (source[0] != '?' || source[1] != '#' || source[2] != '#')
+        return {error::invalid_encoding};
+
+      std::uint16_t id = std::uint16_t(source[3]) << 8;
+      id |= source[4] & 0xFF;
+
+      remaining = std::uint32_t(source[5]) << 24;
+      remaining |= std::uint32_t(source[6]) << 16;
+      remaining |= std::uint32_t(source[7]) << 8;
+      remaining |= source[8];
+
+      const std::uint32_t next = std::min(std::uint32_t(report_size - 9), remaining);
+      dest.write({source + 9, next});
+      remaining -= next;
+      return id;
+    }
+
+    expect<void> unpack_next(const report& source, byte_stream& dest, std::uint32_t& remaining)
+    {
+      if (source[0] != '?')
+        return {error::invalid_encoding};
+
+      const std::uint32_t next = std::min(std::uint32_t(report_size - 1), remaining);
+      dest.write({source + 1, next});
+      remaining -= next;
+      return ::success();
+    }
+  }
+}
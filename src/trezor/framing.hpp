@@ -0,0 +1,63 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "expect.hpp"
+#include "trezor/common.hpp"
+
+class byte_chain;
+class byte_stream;
+
+namespace trezor
+{
+  //! Packing of protocol messages into 64-byte USB reports.
+  namespace framing
+  {
+    constexpr const std::size_t report_size = 64;
+    using report = std::uint8_t[report_size];
+
+    /*! Write the first report of message `id` into `dest`, moving the start
+        of `payload` into it and zero padding the rest.
+        \pre `payload.size()` fits in 32 bits. */
+    void pack_first(report& dest, message_id id, byte_chain& payload) noexcept;
+
+    //! Write a continuation report, moving the start of `payload` into it.
+    void pack_next(report& dest, byte_chain& payload) noexcept;
+
+    /*! Append the payload of a first report to `dest`, and set `remaining`
+        to the payload bytes still expected in continuation reports.
+        \return Message id. */
+    expect<std::uint16_t> unpack_first(const report& source, byte_stream& dest, std::uint32_t& remaining);
+
+    //! Append the payload of a continuation report to `dest`.
+    expect<void> unpack_next(const report& source, byte_stream& dest, std::uint32_t& remaining);
+  }
+}
@@ -0,0 +1,209 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "trezor/identity.hpp"
+
+#include <cstring>
+#include <vector>
+
+#include "byte_stream.hpp"
+#include "crypto/hkdf_sha256.h"
+#include "crypto/sha256.h"
+#include "error.hpp"
+#include "host_info.hpp"
+#include "trezor/crypto.hpp"
+
+namespace trezor
+{
+  namespace
+  {
+    address get_path(const std::array<unsigned char, crypto_hash_sha256_BYTES>& hash)
+    {
+      address out{{hardened_path | 17}};
+
+      auto bytes = to_span(hash);
+      for (std::size_t i = 1; i < out.size(); ++i)
+      {
+        std::uint32_t val = bytes[0];
+        val |= bytes[1] << 8;
+        val |= bytes[2] << 16;
+        val |= bytes[3] << 24;
+        out[i] = hardened_path | val;
+        bytes.remove_prefix(4);
+      }
+
+      return out;
+    }
+
+    expect<address> get_path(const std::string& source)
+    {
+      std::array<unsigned char, crypto_hash_sha256_BYTES> hash{{}};
+      if (crypto_hash_sha256(hash.data(), reinterpret_cast<const unsigned char*>(source.data()), source.size()))
+        return {common_error::hash_failure};
+      return get_path(hash);
+    }
+
+    //! \return `get_path` for each of `sources`, hashed in SIMD lanes.
+    expect<std::vector<address>> get_paths(const std::vector<std::string>& sources)
+    {
+      std::vector<const unsigned char*> in(sources.size());
+      std::vector<unsigned long long> inlen(sources.size());
+      for (std::size_t i = 0; i < sources.size(); ++i)
+      {
+        in[i] = reinterpret_cast<const unsigned char*>(sources[i].data());
+        inlen[i] = sources[i].size();
+      }
+
+      std::vector<std::array<unsigned char, crypto_hash_sha256_BYTES>> hashes(sources.size());
+      auto* const dest = reinterpret_cast<unsigned char (*)[crypto_hash_sha256_BYTES]>(hashes.data());
+      if (crypto_hash_sha256_many(dest, in.data(), inlen.data(), sources.size()))
+        return {common_error::hash_failure};
+
+      std::vector<address> out;
+      out.reserve(hashes.size());
+      for (const auto& hash : hashes)
+        out.push_back(get_path(hash));
+      return out;
+    }
+
+    std::string peer_key_uri(const host_info& info)
+    {
+      return "macer_peerkey://" + info.user + "@" + info.host;
+    }
+
+    std::string ecdh_message(const identity& ident)
+    {
+      static constexpr const char index[4] = {0, 0, 0, 0}; // little-endian `identity.index`
+      return std::string{index, sizeof(index)} + serialize(ident);
+    }
+  }
+
+  expect<address> peer_key_path(const host_info& info)
+  {
+    /* This could be a fixed path for a nothing-up-my-sleeves approach, but
+      introducing a hashed path is pretty simple and removes a fixed
+      public-key to crack. */
+    return get_path(peer_key_uri(info));
+  }
+
+  expect<std::vector<address>> peer_key_paths(const span<const host_info> hosts)
+  {
+    std::vector<std::string> uris;
+    uris.reserve(hosts.size());
+    for (const host_info& info : hosts)
+      uris.push_back(peer_key_uri(info));
+    return get_paths(uris);
+  }
+
+  expect<address> ecdh_path(const identity& ident)
+  {
+    return get_path(ecdh_message(ident));
+  }
+
+  expect<std::vector<address>> ecdh_paths(const span<const host_info> hosts)
+  {
+    std::vector<std::string> messages;
+    messages.reserve(hosts.size());
+    for (const host_info& info : hosts)
+      messages.push_back(ecdh_message(make_identity(info)));
+    return get_paths(messages);
+  }
+
+  std::string serialize(const identity& ident)
+  {
+    std::string out;
+    if (!ident.protocol.empty())
+      out += ident.protocol + "://";
+    if (!ident.user.empty())
+      out += ident.user + "@";
+    out += ident.host;
+    return out;
+  }
+
+  identity make_identity(const host_info& info)
+  {
+    return {"macer", info.user, info.host};
+  }
+
+  expect<byte_slice> session_secret(const span<const std::uint8_t> shared)
+  {
+    byte_stream hash;
+    hash.put_n(0, crypto_hash_sha256_BYTES);
+
+    if (crypto_hash_sha256(hash.data(), shared.data(), shared.size()))
+      return {common_error::hash_failure};
+
+    return byte_slice{std::move(hash)};
+  }
+
+  expect<std::vector<byte_slice>> session_secrets(const span<const shared_secret> shared)
+  {
+    std::vector<const unsigned char*> in(shared.size());
+    std::vector<unsigned long long> inlen(shared.size());
+    for (std::size_t i = 0; i < shared.size(); ++i)
+    {
+      in[i] = shared[i].data();
+      inlen[i] = shared[i].size();
+    }
+
+    std::vector<std::array<unsigned char, crypto_hash_sha256_BYTES>> hashes(shared.size());
+    auto* const dest = reinterpret_cast<unsigned char (*)[crypto_hash_sha256_BYTES]>(hashes.data());
+    const int rc = crypto_hash_sha256_many(dest, in.data(), inlen.data(), shared.size());
+
+    std::vector<byte_slice> out;
+    out.reserve(hashes.size());
+    for (std::size_t i = 0; !rc && i < hashes.size(); ++i)
+    {
+      byte_stream hash;
+      hash.write(to_span(hashes[i]));
+      out.push_back(byte_slice{std::move(hash)});
+    }
+    explicit_bzero(hashes.data(), hashes.size() * sizeof(hashes[0]));
+    if (rc)
+      return {common_error::hash_failure};
+    return out;
+  }
+
+  expect<byte_slice> expand_secret(const span<const std::uint8_t> session, const span<const char> label, const std::size_t size)
+  {
+    static constexpr const char salt[] = "macer derive";
+
+    MACER_PRECOND(size <= crypto_kdf_hkdf_sha256_BYTES_MAX);
+    unsigned char key[crypto_kdf_hkdf_sha256_KEYBYTES] = {0};
+    if (crypto_kdf_hkdf_sha256_extract(key, reinterpret_cast<const unsigned char*>(salt), sizeof(salt) - 1, session.data(), session.size()))
+      return {common_error::hash_failure};
+
+    byte_stream out;
+    out.put_n(0, size);
+    const int rc = crypto_kdf_hkdf_sha256_expand(out.data(), size, label.data(), label.size(), key);
+    explicit_bzero(key, sizeof(key));
+    if (rc)
+      return {common_error::hash_failure};
+
+    return byte_slice{std::move(out)};
+  }
+}
@@ -0,0 +1,82 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "byte_slice.hpp"
+#include "expect.hpp"
+#include "span.hpp"
+
+struct host_info;
+
+namespace trezor
+{
+  struct identity;
+
+  //! SLIP-13/17 style derivation path: `17'` followed by 4 hashed indexes.
+  using address = std::array<std::uint32_t, 5>;
+
+  //! x25519 shared secret: the ECDH session key without its 1-byte prefix.
+  using shared_secret = std::array<std::uint8_t, 32>;
+
+  //! \return `get_public_key` path for the `macer_peerkey://user@host` peer key.
+  expect<address> peer_key_path(const host_info& info);
+
+  //! \return `peer_key_path` for each of `hosts`, hashed in SIMD lanes.
+  expect<std::vector<address>> peer_key_paths(span<const host_info> hosts);
+
+  /*! \return Path the firmware derives for `get_ecdh_session` (SLIP-17):
+        SHA-256 of a zero index and the serialized `ident`. */
+  expect<address> ecdh_path(const identity& ident);
+
+  //! \return `ecdh_path(make_identity(info))` for each of `hosts`, hashed in SIMD lanes.
+  expect<std::vector<address>> ecdh_paths(span<const host_info> hosts);
+
+  //! \return `ident` serialized as `proto://user@host` like the firmware.
+  std::string serialize(const identity& ident);
+
+  //! \return `identity` macer sends to the device for `info`.
+  identity make_identity(const host_info& info);
+
+  /*! \return Password secret from an x25519 shared secret (the ECDH session
+        key without its 1-byte prefix). */
+  expect<byte_slice> session_secret(span<const std::uint8_t> shared);
+
+  //! \return `session_secret` for each of `shared`, hashed in SIMD lanes.
+  expect<std::vector<byte_slice>> session_secrets(span<const shared_secret> shared);
+
+  /*! \return `size` bytes of HKDF-SHA256 output keyed by `session` (the
+        `session_secret` of one device confirmation) for `label`. Different
+        labels give independent secrets from the same ECDH session. */
+  expect<byte_slice> expand_secret(span<const std::uint8_t> session, span<const char> label, std::size_t size);
+}
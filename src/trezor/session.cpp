@@ -0,0 +1,350 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "trezor/session.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include "byte_chain.hpp"
+#include "error.hpp"
+#include "metrics.hpp"
+#include "trace.hpp"
+#include "trezor/crypto.hpp"
+#include "trezor/error.hpp"
+#include "trezor/identity.hpp"
+#include "wire/protobuf.hpp"
+
+namespace trezor
+{
+  namespace
+  {
+    template<typename T>
+    expect<T> decode(byte_slice&& bytes)
+    {
+      const timing::scope decoding{timing::phase::protobuf};
+      return wire::protobuf::from_bytes<T>(std::move(bytes));
+    }
+  } // anonymous
+
+  session::session(std::vector<host_info> hosts, const bool legacy)
+    : hosts_(std::move(hosts)),
+      secrets_(),
+      output_(),
+      message_(),
+      failure_(),
+      error_(),
+      sent_(),
+      remaining_(0),
+      sent_id_(0),
+      received_id_(0),
+      step_(step::initialize),
+      wait_(wait::report),
+      legacy_(legacy),
+      partial_(false),
+      pending_(false)
+  {
+    secrets_.reserve(hosts_.size());
+  }
+
+  session::wait session::fail(const std::error_code error) noexcept
+  {
+    error_ = error;
+    return wait_ = wait::failed;
+  }
+
+  session::wait session::send(const message_id id, byte_chain bytes)
+  {
+    const trace::span sending{"send_message", "trezor", "id", std::uint16_t(id)};
+    const timing::scope packing{timing::phase::framing};
+    framing::report buffer;
+
+    framing::pack_first(buffer, id, bytes);
+    output_.write(buffer, sizeof(buffer));
+    while (!bytes.empty())
+    {
+      framing::pack_next(buffer, bytes);
+      output_.write(buffer, sizeof(buffer));
+    }
+
+    sent_ = std::chrono::steady_clock::now();
+    sent_id_ = std::uint16_t(id);
+    pending_ = true;
+    return wait_ = wait::report;
+  }
+
+  template<typename T>
+  session::wait session::send(const T& message)
+  {
+    byte_chain bytes;
+    const std::error_code error = timing::measure(
+      timing::phase::protobuf, [&] { return wire::protobuf::to_bytes(bytes, message); }
+    );
+    if (error)
+      return fail(error);
+    if (std::numeric_limits<std::uint32_t>::max() < bytes.size())
+      return fail(common_error::invalid_argument);
+    return send(message.id(), std::move(bytes));
+  }
+
+  session::wait session::request_next()
+  {
+    if (hosts_.size() <= secrets_.size())
+      return wait_ = wait::done;
+
+    const host_info& info = hosts_[secrets_.size()];
+    if (legacy_)
+    {
+      step_ = step::secret;
+      return send(sign_identity{make_identity(info), "macer_luks_drive", info.message, "ed25519"});
+    }
+
+    const expect<address> path = peer_key_path(info);
+    if (!path)
+      return fail(path.error());
+    step_ = step::public_key;
+    return send(get_public_key{"curve25519", *path});
+  }
+
+  void session::observe_response() noexcept
+  {
+    if (!pending_)
+      return;
+
+    pending_ = false;
+    const auto elapsed = std::chrono::steady_clock::now() - sent_;
+    metrics::registry& stats = metrics::get();
+    if (wait_ == wait::button)
+      stats.button_seconds.observe(elapsed);
+    else if (sent_id_ < metrics::registry::max_message_id)
+      stats.request_seconds[sent_id_].observe(elapsed);
+  }
+
+  session::wait session::handle_failure(byte_slice&& bytes)
+  {
+    auto message = decode<trezor::failure>(std::move(bytes));
+    if (!message)
+      return fail(message.error());
+    failure_ = std::move(message->message);
+    return fail(trezor::error::device_failure);
+  }
+  session::wait session::handle_public_key(byte_slice&& bytes)
+  {
+    if (step_ != step::public_key)
+      return fail(trezor::error::unsupported_message);
+    const auto message = decode<trezor::public_key>(std::move(bytes));
+    if (!message)
+      return fail(message.error());
+
+    const span<const std::uint8_t> peer_pubkey = as_byte_span(message->node.public_key);
+    get_ecdh_session request{make_identity(hosts_[secrets_.size()]), "curve25519"};
+    std::memcpy(std::addressof(request.peer_key), peer_pubkey.data(), std::min(peer_pubkey.size(), sizeof(request.peer_key)));
+    request.peer_key.data[0] = 0x40;
+    step_ = step::secret;
+    return send(request);
+  }
+  session::wait session::handle_features(byte_slice&&)
+  {
+    if (step_ != step::initialize)
+      return wait_ = wait::report;
+    return request_next();
+  }
+  session::wait session::handle_pin(byte_slice&&)
+  {
+    return wait_ = wait::pin;
+  }
+  session::wait session::handle_button(byte_slice&&)
+  {
+    send(button_ack{});
+    if (wait_ == wait::failed)
+      return wait_;
+    return wait_ = wait::button;
+  }
+  session::wait session::handle_passphrase(byte_slice&&)
+  {
+    return wait_ = wait::passphrase;
+  }
+  session::wait session::handle_signature(byte_slice&& bytes)
+  {
+    if (step_ != step::secret || !legacy_)
+      return fail(trezor::error::unsupported_message);
+    const auto message = decode<trezor::signed_identity>(std::move(bytes));
+    static_assert(sizeof(message->signature) == 65, "unexpected signature size");
+    /* Trezor returns 65 byte signatures even though ed25519 produces 64-byte
+       signature. The first byte is random garbage due to a bug in the Trezor v1
+       firmware. */
+    if (!message)
+      return fail(message.error());
+    auto sig = as_byte_span(message->signature);
+    sig.remove_prefix(1);
+    secrets_.push_back(byte_slice{sig});
+    return request_next();
+  }
+  session::wait session::handle_ecdh_session(byte_slice&& bytes)
+  {
+    if (step_ != step::secret || legacy_)
+      return fail(trezor::error::unsupported_message);
+    const auto message = decode<trezor::ecdh_session>(std::move(bytes));
+    if (!message)
+      return fail(message.error());
+
+    static_assert(sizeof(message->secret_key) == 33, "unexpected ecdh secret size");
+
+    /* Trezor prefixes the x25519 key with a non-standard value. Just drop it,
+      no entropy is provided by this value. */
+    auto key = as_byte_span(message->secret_key);
+    key.remove_prefix(1); // non-standared prefix
+
+    expect<byte_slice> secret = timing::measure(timing::phase::hashing, [key] { return session_secret(key); });
+    if (!secret)
+      return fail(secret.error());
+    secrets_.push_back(std::move(*secret));
+    return request_next();
+  }
+
+  session::wait session::dispatch(const std::uint16_t id, byte_slice bytes)
+  {
+    struct message_map
+    {
+      typedef wait(session::*handler_func)(byte_slice&&);
+      handler_func handler;
+      message_id id;
+      const char* name; //!< Trace span name
+    };
+
+    static constexpr const message_map handlers[] =
+    {
+      {&session::handle_failure, message_id::failure, "handle_failure"},
+      {&session::handle_public_key, message_id::public_key, "handle_public_key"},
+      {&session::handle_features, message_id::features, "handle_features"},
+      {&session::handle_pin, message_id::pin_matrix_request, "handle_pin"},
+      {&session::handle_button, message_id::button_request, "handle_button"},
+      {&session::handle_passphrase, message_id::passphrase_request, "handle_passphrase"},
+      {&session::handle_signature, message_id::signed_identity, "handle_signature"},
+      {&session::handle_ecdh_session, message_id::ecdh_session, "handle_ecdh_session"}
+    };
+
+    const auto found = std::lower_bound(
+      std::begin(handlers), std::end(handlers), message_id(id),
+      [] (const message_map& lhs, const message_id rhs) { return lhs.id < rhs; }
+    );
+    if (found == std::end(handlers) || found->id != message_id(id))
+    {
+      metrics::get().message_errors.add();
+      return fail(trezor::error::unsupported_message);
+    }
+
+    metrics::get().messages_received.add();
+    const trace::span handling{found->name, "handler", "id", id};
+    return (this->*(found->handler))(std::move(bytes));
+  }
+
+  session::wait session::start()
+  {
+    if (step_ != step::initialize || wait_ != wait::report || pending_)
+      return fail(common_error::invalid_argument);
+    return send(initialize{});
+  }
+
+  byte_slice session::take_output() noexcept
+  {
+    byte_slice out{std::move(output_), false};
+    output_ = byte_stream{};
+    return out;
+  }
+
+  session::wait session::on_report(const framing::report& source)
+  {
+    if (wait_ != wait::report && wait_ != wait::button)
+      return fail(common_error::invalid_argument);
+
+    const timing::scope unpacking{timing::phase::framing};
+    if (!partial_)
+    {
+      observe_response();
+      message_ = byte_stream{};
+      const expect<std::uint16_t> id = framing::unpack_first(source, message_, remaining_);
+      if (!id)
+      {
+        metrics::get().message_errors.add();
+        return fail(id.error());
+      }
+      received_id_ = *id;
+    }
+    else
+    {
+      const expect<void> next = framing::unpack_next(source, message_, remaining_);
+      if (!next)
+      {
+        metrics::get().message_errors.add();
+        return fail(next.error());
+      }
+    }
+
+    partial_ = remaining_ != 0;
+    if (partial_)
+      return wait_ = wait::report;
+    return dispatch(received_id_, byte_slice{std::move(message_)});
+  }
+
+  session::wait session::on_input(std::string value)
+  {
+    if (wait_ == wait::pin)
+      return send(pin_matrix_ack{std::move(value)});
+    if (wait_ == wait::passphrase)
+      return send(passphrase_ack{std::move(value)});
+    return fail(common_error::invalid_argument);
+  }
+
+  session::wait session::on_timeout() noexcept
+  {
+    if (wait_ == wait::done || wait_ == wait::failed)
+      return wait_;
+    return fail(trezor::error::timed_out);
+  }
+
+  timing::phase session::phase() const noexcept
+  {
+    switch (step_)
+    {
+    case step::initialize:
+      return timing::phase::initialize;
+    case step::public_key:
+      return timing::phase::public_key;
+    default:
+    case step::secret:
+      break;
+    }
+    return legacy_ ? timing::phase::sign_identity : timing::phase::ecdh_session;
+  }
+
+  std::vector<byte_slice> session::take_secrets() noexcept
+  {
+    return std::move(secrets_);
+  }
+}
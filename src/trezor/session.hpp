@@ -0,0 +1,142 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "byte_slice.hpp"
+#include "byte_stream.hpp"
+#include "host_info.hpp"
+#include "timing.hpp"
+#include "trezor/common.hpp"
+#include "trezor/framing.hpp"
+
+class byte_chain;
+
+namespace trezor
+{
+  /*! \brief Resumable exchange with one device: `initialize`, then a secret
+        for each host.
+
+      The session does no I/O and never blocks. The caller writes
+      `take_output()` to the device after every call, then feeds back the
+      event it was told to wait for (a report read from the device, user
+      input, or a timeout). One thread can drive many sessions, and answer
+      PIN or passphrase requests from any source, without blocking in the
+      middle of an exchange. Not thread safe; each session is driven by one
+      thread at a time. */
+  class session
+  {
+  public:
+    //! Event needed to resume the session.
+    enum class wait : std::uint8_t
+    {
+      report = 0, //!< `on_report` with the next report from the device
+      button,     //!< `on_report` after the user confirms on the device
+      pin,        //!< `on_input` with PIN matrix positions
+      passphrase, //!< `on_input` with the device passphrase
+      done,       //!< `take_secrets()` has one secret per host
+      failed      //!< `error()` is set
+    };
+
+    session(std::vector<host_info> hosts, bool legacy);
+
+    session(const session&) = delete;
+    session& operator=(const session&) = delete;
+
+    //! Queue `initialize`. \return Event to wait for.
+    wait start();
+
+    /*! \return Reports to write to the device before waiting, in order,
+          `framing::report_size` bytes each. */
+    byte_slice take_output() noexcept;
+
+    //! \return Event to wait for after `source` was read from the device.
+    wait on_report(const framing::report& source);
+
+    //! \return Event to wait for after the user answered `wait::pin` or `wait::passphrase`.
+    wait on_input(std::string value);
+
+    //! The wait expired. \return `wait::failed` unless already finished.
+    wait on_timeout() noexcept;
+
+    wait current() const noexcept { return wait_; }
+
+    //! \return Round trip being waited on, for `timing::scope`.
+    timing::phase phase() const noexcept;
+
+    //! \return Reason for `wait::failed`.
+    std::error_code error() const noexcept { return error_; }
+
+    //! \return Text of the device `failure` message, if one caused `wait::failed`.
+    const std::string& failure() const noexcept { return failure_; }
+
+    //! \pre `current() == wait::done` \return One secret per host, in order.
+    std::vector<byte_slice> take_secrets() noexcept;
+
+  private:
+    enum class step : std::uint8_t { initialize = 0, public_key, secret };
+
+    wait fail(std::error_code error) noexcept;
+    wait send(message_id id, byte_chain bytes);
+    template<typename T>
+    wait send(const T& message);
+    wait request_next();
+    wait dispatch(std::uint16_t id, byte_slice bytes);
+    void observe_response() noexcept;
+
+    wait handle_failure(byte_slice&& bytes);
+    wait handle_public_key(byte_slice&& bytes);
+    wait handle_features(byte_slice&& bytes);
+    wait handle_pin(byte_slice&& bytes);
+    wait handle_button(byte_slice&& bytes);
+    wait handle_passphrase(byte_slice&& bytes);
+    wait handle_signature(byte_slice&& bytes);
+    wait handle_ecdh_session(byte_slice&& bytes);
+
+    const std::vector<host_info> hosts_;
+    std::vector<byte_slice> secrets_;
+    byte_stream output_;
+    byte_stream message_;   //!< Payload of a message spanning reports
+    std::string failure_;
+    std::error_code error_;
+    std::chrono::steady_clock::time_point sent_; //!< Last request, until its first report
+    std::uint32_t remaining_; //!< Payload bytes in continuation reports
+    std::uint16_t sent_id_;
+    std::uint16_t received_id_; //!< Id of the message in `message_`
+    step step_;
+    wait wait_;
+    const bool legacy_;
+    bool partial_;  //!< Next report continues `message_`
+    bool pending_;  //!< Response to `sent_id_` not started
+  };
+}
@@ -0,0 +1,263 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "trezor/software.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+
+#include "crypto/bip39/decoder.hpp"
+#include "crypto/pbkdf2.h"
+#include "crypto/x25519.h"
+#include "error.hpp"
+#include "host_info.hpp"
+#include "logger.hpp"
+#include "trezor/crypto.hpp"
+#include "trezor/identity.hpp"
+
+namespace trezor
+{
+  namespace
+  {
+    constexpr const std::uint64_t bip39_iterations = 2048;
+
+    //! \return `mnemonic` with words separated by one space, like the firmware.
+    expect<std::string> normalize(const span<const char> mnemonic)
+    {
+      {
+        const expect<byte_slice> entropy = bip39::decode(mnemonic);
+        if (!entropy)
+          return entropy.error();
+      }
+
+      std::string out;
+      out.reserve(mnemonic.size());
+      for (const char c : mnemonic)
+      {
+        const bool space = (c == ' ' || c == '\t' || c == '\n' || c == '\r');
+        if (!space)
+          out.push_back(c);
+        else if (!out.empty() && out.back() != ' ')
+          out.push_back(' ');
+      }
+      if (!out.empty() && out.back() == ' ')
+        out.pop_back();
+      return out;
+    }
+
+    std::string make_salt(const span<const char> passphrase)
+    {
+      std::string out = "mnemonic";
+      out.append(passphrase.data(), passphrase.size());
+      return out;
+    }
+
+    //! Private keys the device derives for `info` in `usb::run`.
+    struct device_keys
+    {
+      slip10::node peer; //!< `get_public_key` at `peer_key_path`
+      slip10::node ecdh; //!< `get_ecdh_session` at `ecdh_path`
+    };
+
+    /*! \return Keys at `peer_path` and `session_path`, where
+          `derive_path(path)` returns the node at `path` below the master
+          node. */
+    template<typename F>
+    expect<device_keys> derive_keys(F derive_path, const address& peer_path, const address& session_path)
+    {
+      expect<slip10::node> peer = derive_path(to_span(peer_path));
+      if (!peer)
+        return peer.error();
+      expect<slip10::node> ecdh = derive_path(to_span(session_path));
+      if (!ecdh)
+        return ecdh.error();
+      return device_keys{std::move(*peer), std::move(*ecdh)};
+    }
+
+    void wipe(std::string& source) noexcept
+    {
+      explicit_bzero(&source[0], source.size());
+    }
+
+    //! Wipes a string of mnemonic or passphrase bytes on every return path.
+    struct wipe_on_exit
+    {
+      std::string& source;
+      ~wipe_on_exit() { wipe(source); }
+    };
+
+    const unsigned char* to_uchar(const std::string& source) noexcept
+    {
+      return reinterpret_cast<const unsigned char*>(source.data());
+    }
+  } // anonymous
+
+  expect<slip10::seed> software::make_seed(const span<const char> mnemonic, const span<const char> passphrase)
+  {
+    expect<std::string> normalized = normalize(mnemonic);
+    if (!normalized)
+      return normalized.error();
+    const wipe_on_exit wipe_mnemonic{*normalized};
+    std::string salt = make_salt(passphrase);
+    const wipe_on_exit wipe_salt{salt};
+
+    slip10::seed out{};
+    const int rc = crypto_pbkdf2_sha512(
+      out.bytes.data(), out.bytes.size(),
+      to_uchar(*normalized), normalized->size(),
+      to_uchar(salt), salt.size(),
+      bip39_iterations
+    );
+    if (rc)
+      return {common_error::hash_failure};
+    return out;
+  }
+
+  expect<byte_slice> software::run(const slip10::seed& seed, const host_info& info)
+  {
+    const expect<address> peer_path = peer_key_path(info);
+    if (!peer_path)
+      return peer_path.error();
+    const expect<address> session_path = ecdh_path(make_identity(info));
+    if (!session_path)
+      return session_path.error();
+
+    const slip10::node master = slip10::curve25519_master(seed);
+    const expect<device_keys> keys = derive_keys(
+      [&master] (const span<const std::uint32_t> path) { return slip10::derive(master, path); },
+      *peer_path, *session_path
+    );
+    if (!keys)
+      return keys.error();
+
+    // `usb::run` step 1: `get_public_key` at the hashed peer key path
+    const std::array<std::uint8_t, 33> peer_key = slip10::curve25519_public_key(keys->peer);
+
+    // `usb::run` step 2: `get_ecdh_session`; firmware skips the 0x40 prefix
+    std::uint8_t shared[crypto_scalarmult_curve25519_BYTES];
+    if (crypto_scalarmult_curve25519(shared, keys->ecdh.key.data(), peer_key.data() + 1))
+      return {common_error::hash_failure};
+
+    expect<byte_slice> out = session_secret(shared);
+    explicit_bzero(shared, sizeof(shared));
+    return out;
+  }
+
+  std::unique_ptr<slip10::cache> software::make_cache(const slip10::seed& seed)
+  {
+    static constexpr const std::size_t cached_nodes = 64;
+    static std::atomic<bool> reported{false};
+
+    expect<slip10::cache> nodes = slip10::cache::make(slip10::curve25519_master(seed), cached_nodes);
+    if (!nodes)
+    {
+      if (!reported.exchange(true))
+        MACER_LOG_ERROR(nodes.error(), "SLIP-10 node cache unavailable, deriving without it");
+      return nullptr;
+    }
+    return std::unique_ptr<slip10::cache>{new slip10::cache{std::move(*nodes)}};
+  }
+
+  expect<std::vector<byte_slice>> software::run(const slip10::seed& seed, const span<const host_info> hosts)
+  {
+    const std::unique_ptr<slip10::cache> nodes = make_cache(seed);
+    return run(seed, hosts, nodes.get());
+  }
+
+  expect<std::vector<byte_slice>>
+    software::run(const slip10::seed& seed, const span<const host_info> hosts, slip10::cache* const nodes)
+  {
+    static constexpr const std::size_t lanes = 4;
+
+    // every path shares `m/17'`; the cache skips it and the key midstates
+    const slip10::node master = slip10::curve25519_master(seed);
+    const auto derive_path = [&master, nodes] (const span<const std::uint32_t> path)
+    {
+      if (nodes)
+        return nodes->derive(path);
+      return slip10::derive(master, path); // no locked memory, skip caching
+    };
+
+    // both path hashes for every host, in SIMD lanes
+    const expect<std::vector<address>> peer_paths = peer_key_paths(hosts);
+    if (!peer_paths)
+      return peer_paths.error();
+    const expect<std::vector<address>> session_paths = ecdh_paths(hosts);
+    if (!session_paths)
+      return session_paths.error();
+
+    std::vector<device_keys> keys;
+    keys.reserve(hosts.size());
+    for (std::size_t i = 0; i < hosts.size(); ++i)
+    {
+      expect<device_keys> next = derive_keys(derive_path, (*peer_paths)[i], (*session_paths)[i]);
+      if (!next)
+        return next.error();
+      keys.push_back(std::move(*next));
+    }
+
+    // `get_public_key` for every host: fixed-base comb, one shared inversion
+    std::vector<std::array<unsigned char, crypto_scalarmult_curve25519_BYTES>> peer_keys(keys.size());
+    {
+      std::vector<const unsigned char*> peer(keys.size());
+      for (std::size_t i = 0; i < keys.size(); ++i)
+        peer[i] = keys[i].peer.key.data();
+      auto* const dest = reinterpret_cast<unsigned char (*)[crypto_scalarmult_curve25519_BYTES]>(peer_keys.data());
+      if (!keys.empty() && crypto_scalarmult_curve25519_base_many(dest, peer.data(), peer.size()))
+        return {common_error::hash_failure};
+    }
+
+    std::vector<shared_secret> shared(keys.size());
+    bool failed = false;
+    for (std::size_t i = 0; !failed && i < keys.size(); i += lanes)
+    {
+      // a short final group repeats its last entry in the unused lanes
+      const unsigned char* ecdh[lanes];
+      const unsigned char* point[lanes];
+      for (std::size_t j = 0; j < lanes; ++j)
+      {
+        const std::size_t index = std::min(i + j, keys.size() - 1);
+        ecdh[j] = keys[index].ecdh.key.data();
+        point[j] = peer_keys[index].data();
+      }
+
+      unsigned char group[lanes][crypto_scalarmult_curve25519_BYTES];
+      failed = crypto_scalarmult_curve25519_x4(group, ecdh, point);
+      for (std::size_t j = 0; !failed && j < lanes && i + j < keys.size(); ++j)
+        std::memcpy(shared[i + j].data(), group[j], sizeof(group[j]));
+      explicit_bzero(group, sizeof(group));
+    }
+
+    // every session secret at once, in SIMD lanes
+    expect<std::vector<byte_slice>> out = failed ?
+      expect<std::vector<byte_slice>>{common_error::hash_failure} : session_secrets(to_span(shared));
+    explicit_bzero(shared.data(), shared.size() * sizeof(shared[0]));
+    return out;
+  }
+}
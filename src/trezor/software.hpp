@@ -0,0 +1,70 @@
+// Copyright (c) 2026, Cifro Codes
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "byte_slice.hpp"
+#include "crypto/slip10.hpp"
+#include "expect.hpp"
+#include "span.hpp"
+
+struct host_info;
+
+namespace trezor
+{
+  //! Reproduces the device derivation offline from the BIP-39 backup.
+  struct software
+  {
+    /*! \return BIP-39 seed for `mnemonic` and Trezor `passphrase`. The
+          mnemonic checksum is validated; the passphrase must already be
+          NFKD normalized (ASCII always is). */
+    static expect<slip10::seed> make_seed(span<const char> mnemonic, span<const char> passphrase);
+
+    /*! \return Same secret as `usb::run(dev, info, false)` on a device
+          loaded with `seed`. The legacy (signature) scheme is unsupported. */
+    static expect<byte_slice> run(const slip10::seed& seed, const host_info& info);
+
+    /*! \return Node cache for `run` below the master node of `seed`, or
+          `nullptr` when locked memory is unavailable (logged once per
+          process). Not thread-safe; use one per thread. */
+    static std::unique_ptr<slip10::cache> make_cache(const slip10::seed& seed);
+
+    /*! \return `run(seed, host)` for each entry of `hosts`, in order. Peer
+          public keys use the fixed-base comb with one shared inversion, and
+          the ECDH ladders run four at a time in SIMD lanes when supported.
+          `nodes` is from `make_cache(seed)` and keeps the shared path
+          prefix across calls; `nullptr` derives every node from the seed. */
+    static expect<std::vector<byte_slice>>
+      run(const slip10::seed& seed, span<const host_info> hosts, slip10::cache* nodes);
+
+    //! \return `run(seed, hosts, make_cache(seed).get())`.
+    static expect<std::vector<byte_slice>> run(const slip10::seed& seed, span<const host_info> hosts);
+  };
+}
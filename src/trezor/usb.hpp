@@ -27,7 +27,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <vector>
 #include "byte_slice.hpp"
 #include "expect.hpp"
 #include "../usb.hpp"
@@ -45,6 +47,9 @@ namespace trezor
   struct usb
   {
     static expect<::usb::interface> select(span<const libusb_interface> interfaces, bool og_firmare);
-    static expect<byte_slice> run(::usb::device& dev, const host_info& info, bool legacy);
+    /*! \return Secret for each of `hosts`, in order, after one `initialize`
+          (so PIN and passphrase are entered once). Reads poll `stop`, and
+          no prompt is started once it is set. */
+    static expect<std::vector<byte_slice>> run(::usb::device& dev, span<const host_info> hosts, bool legacy, const std::atomic<bool>& stop);
   };
 }
@@ -3,6 +3,9 @@
 #include <algorithm>
 #include <limits>
 #include "logger.hpp"
+#include "metrics.hpp"
+#include "timing.hpp"
+#include "trace.hpp"
 #include "trezor/usb.hpp"
 
 #define MACER_LIBUSB_CHECK(error_return, ...)			\
@@ -12,6 +15,7 @@
     if (rc < 0)							\
     {								\
       const std::error_code code{usb::error(rc)};		\
+      metrics::usb_error(rc);					\
       MACER_LOG_ERROR(code);					\
       return error_return;					\
     }								\
@@ -62,8 +66,9 @@ namespace usb
 namespace
 {
   template<typename T>
-  expect<byte_slice> open_and_run(libusb_context& ctx, libusb_device& dev, const host_info& info, const bool legacy, const bool og_firmware)
+  expect<usb::device> open_device(libusb_device& dev, const bool og_firmware)
   {
+    const timing::scope opening{timing::phase::open};
     device_ptr handle;
     {
       libusb_device_handle* temp = nullptr;
@@ -85,11 +90,12 @@ namespace
     }
 
     MACER_LIBUSB_CHECK(code, libusb_claim_interface(handle.get(), selected->number));
-    usb::device real{std::move(handle), selected->in_endpoint, selected->out_endpoint};
-    return T::run(real, info, legacy);
+    return usb::device{std::move(handle), selected->in_endpoint, selected->out_endpoint};
   }
 
-  expect<void> transfer(libusb_device_handle* dev, const std::uint8_t endpoint, span<std::uint8_t> bytes, const std::chrono::milliseconds timeout)
+  /*! \param idle Set instead of failing when `timeout` expires before the
+        first byte, if not `nullptr`. */
+  expect<void> transfer(libusb_device_handle* dev, const std::uint8_t endpoint, span<std::uint8_t> bytes, const std::chrono::milliseconds timeout, bool* idle = nullptr)
   {
     static_assert(std::numeric_limits<int>::max() <= std::numeric_limits<std::size_t>::max(), "unexpected size_t max");
     static constexpr const std::size_t max_send = std::numeric_limits<int>::max();
@@ -100,12 +106,29 @@ namespace
     {
       int actual = 0;
       const std::size_t this_send = std::min(max_send, bytes.size());
-      MACER_LIBUSB_CHECK(
-        code, libusb_interrupt_transfer(
-	  dev, endpoint, bytes.data(), this_send, std::addressof(actual), timeout.count()
-        )
+      const trace::span report{"transfer", "usb", "endpoint", endpoint};
+      const int result = libusb_interrupt_transfer(
+        dev, endpoint, bytes.data(), this_send, std::addressof(actual), timeout.count()
       );
+      if (idle && result == LIBUSB_ERROR_TIMEOUT && actual == 0 && bytes.size() == total)
+      {
+        *idle = true;
+        return success();
+      }
+      MACER_LIBUSB_CHECK(code, result);
       bytes.remove_prefix(actual);
+
+      metrics::registry& stats = metrics::get();
+      if (endpoint & LIBUSB_ENDPOINT_IN)
+      {
+        stats.reports_received.add();
+        stats.bytes_received.add(actual);
+      }
+      else
+      {
+        stats.reports_sent.add();
+        stats.bytes_sent.add(actual);
+      }
     }
     return success();
   }
@@ -133,6 +156,7 @@ namespace usb
   
   context make_context()
   {
+    const timing::scope creating{timing::phase::context};
     libusb_context* handle = nullptr;
     MACER_LIBUSB_CHECK(nullptr, libusb_init(std::addressof(handle)));
     return context{handle};
@@ -146,31 +170,69 @@ namespace usb
   {
     return transfer(dev.get(), dev.out(), {const_cast<std::uint8_t*>(source.data()), source.size()}, timeout);
   }
+  expect<bool> poll(device& dev, span<std::uint8_t> dest, const std::chrono::milliseconds timeout)
+  {
+    bool idle = false;
+    MACER_CHECK(transfer(dev.get(), dev.in(), dest, timeout, std::addressof(idle)));
+    return !idle;
+  }
+
+  void device_free::operator()(device* ptr) const noexcept
+  {
+    delete ptr;
+  }
 
-  expect<byte_slice> run(libusb_context& ctx, const host_info& info, const bool legacy)
+  expect<device_handle> open(libusb_context& ctx)
   {
     std::unique_ptr<libusb_device*[], device_list_free> list;
+    libusb_device* found = nullptr;
+    bool og_firmware = false;
     {
-      libusb_device** temp = nullptr;
-      MACER_LIBUSB_CHECK(code, libusb_get_device_list(std::addressof(ctx), std::addressof(temp)));
-      list.reset(temp);
-    }
-     
-    for (libusb_device** i = list.get(); i && *i; ++i)
-    {
-      libusb_device_descriptor descriptor{};
-      MACER_LIBUSB_CHECK(code, libusb_get_device_descriptor(*i, std::addressof(descriptor)));
-      if (descriptor.idVendor == trezor::vendor_id || descriptor.idVendor == trezor::vendor_id_og)
+      const timing::scope enumerating{timing::phase::enumerate};
       {
-	const bool og_firmware = descriptor.idVendor == trezor::vendor_id_og;
-	span<const std::uint16_t> devices{trezor::devices};
-	if (og_firmware)
-	  devices = span<const std::uint16_t>{trezor::devices_og};
+        libusb_device** temp = nullptr;
+        MACER_LIBUSB_CHECK(code, libusb_get_device_list(std::addressof(ctx), std::addressof(temp)));
+        list.reset(temp);
+      }
 
-	if (std::binary_search(devices.begin(), devices.end(), descriptor.idProduct))
-	  return open_and_run<trezor::usb>(ctx, **i, info, legacy, og_firmware);
+      for (libusb_device** i = list.get(); i && *i && !found; ++i)
+      {
+        libusb_device_descriptor descriptor{};
+        MACER_LIBUSB_CHECK(code, libusb_get_device_descriptor(*i, std::addressof(descriptor)));
+        if (descriptor.idVendor == trezor::vendor_id || descriptor.idVendor == trezor::vendor_id_og)
+        {
+	  og_firmware = descriptor.idVendor == trezor::vendor_id_og;
+	  span<const std::uint16_t> devices{trezor::devices};
+	  if (og_firmware)
+	    devices = span<const std::uint16_t>{trezor::devices_og};
+
+	  if (std::binary_search(devices.begin(), devices.end(), descriptor.idProduct))
+	    found = *i;
+        }
       }
     }
-    return byte_slice{};
+
+    if (!found)
+      return device_handle{};
+
+    expect<device> opened = open_device<trezor::usb>(*found, og_firmware);
+    if (!opened)
+      return opened.error();
+    return device_handle{new device{std::move(*opened)}};
+  }
+
+  expect<std::vector<byte_slice>> run(device& dev, const span<const host_info> hosts, const bool legacy, const std::atomic<bool>& stop)
+  {
+    return trezor::usb::run(dev, hosts, legacy, stop);
+  }
+
+  expect<std::vector<byte_slice>> run(libusb_context& ctx, const span<const host_info> hosts, const bool legacy, const std::atomic<bool>& stop)
+  {
+    expect<device_handle> dev = open(ctx);
+    if (!dev)
+      return dev.error();
+    if (!*dev)
+      return std::vector<byte_slice>{};
+    return run(**dev, hosts, legacy, stop);
   }
 }
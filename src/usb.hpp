@@ -1,10 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <libusb-1.0/libusb.h>
 #include <memory>
 #include <system_error>
+#include <vector>
 #include "byte_slice.hpp"
 #include "expect.hpp"
 #include "span.hpp"
@@ -63,7 +65,30 @@ namespace usb
   expect<void> read(device& source, span<std::uint8_t> dest, std::chrono::milliseconds timeout);
   expect<void> write(device& dest, span<const std::uint8_t> source, std::chrono::milliseconds timeout);
 
-  expect<byte_slice> run(libusb_context& ctx, const host_info& info, bool legacy);
+  /*! `read`, except `timeout` expiring before any byte arrives is not an
+      error (and is not logged).
+      \return False if `timeout` expired first. */
+  expect<bool> poll(device& source, span<std::uint8_t> dest, std::chrono::milliseconds timeout);
+
+  struct device_free
+  {
+    void operator()(device* ptr) const noexcept;
+  };
+
+  using device_handle = std::unique_ptr<device, device_free>;
+
+  /*! \return First supported device, opened with its interface claimed, or
+        `nullptr` if none is attached. */
+  expect<device_handle> open(libusb_context& ctx);
+
+  /*! \return Secret for each of `hosts` from one session with `dev`. The
+        session fails with `trezor::error::timed_out` soon after `stop` is
+        set. */
+  expect<std::vector<byte_slice>> run(device& dev, span<const host_info> hosts, bool legacy, const std::atomic<bool>& stop);
+
+  /*! \return Secret for each of `hosts` from one session with the first
+        supported device, or an empty vector if none is attached. */
+  expect<std::vector<byte_slice>> run(libusb_context& ctx, span<const host_info> hosts, bool legacy, const std::atomic<bool>& stop);
 }
 
 namespace std
@@ -35,6 +35,11 @@ namespace
   constexpr const std::size_t max_object_depth = 100;
   constexpr const std::size_t max_size_t = std::numeric_limits<std::size_t>::max();
 
+  /* Nested objects at least this size are spliced into the parent as a
+     `byte_chain` segment instead of being copied. Smaller objects are copied
+     so that the per-depth buffers are re-used without another allocation. */
+  constexpr const std::size_t min_splice_size = 1024;
+
   template<typename T>
   void write_varint(byte_stream& out, T value)
   {
@@ -139,9 +144,24 @@ namespace wire
       --index_;
     if (index_ != max_size_t)
     {
-      last_id_ = objects_[index_ + 1].id;
-      binary(to_span(objects_[index_ + 1].stream));
-      objects_[index_ + 1].stream.clear(); // re-use allocated memory
+      object_data& parent = objects_[index_];
+      object_data& child = objects_[index_ + 1];
+      last_id_ = child.id;
+
+      const std::size_t length = child.chain.size() + child.stream.size();
+      if (child.chain.empty() && length < min_splice_size)
+      {
+        binary(to_span(child.stream));
+        child.stream.clear(); // re-use allocated memory
+      }
+      else
+      {
+        write_tag(protobuf::type::bytes);
+        write_varint(parent.stream, length);
+        parent.chain.push_back(byte_slice{std::move(parent.stream)});
+        parent.chain.append(std::move(child.chain));
+        parent.chain.push_back(byte_slice{std::move(child.stream)});
+      }
     }
   }
 
@@ -150,8 +170,31 @@ namespace wire
     if (index_ != max_size_t)
       throw std::logic_error{"protobuf_writer::take_sink called on incomplete protobuf stream"};
 
-    byte_stream out{std::move(objects_[0].stream)};
-    objects_[0].stream.clear();
+    object_data& root = objects_[0];
+    if (root.chain.empty())
+    {
+      byte_stream out{std::move(root.stream)};
+      root.stream.clear();
+      return out;
+    }
+
+    byte_stream out{};
+    out.reserve(root.chain.size() + root.stream.size());
+    for (const byte_slice& segment : root.chain)
+      out.write(to_span(segment));
+    out.write(to_span(root.stream));
+    root.chain.clear();
+    root.stream.clear();
+    return out;
+  }
+
+  byte_chain protobuf_writer::take_chain()
+  {
+    if (index_ != max_size_t)
+      throw std::logic_error{"protobuf_writer::take_chain called on incomplete protobuf stream"};
+
+    byte_chain out{std::move(objects_[0].chain)};
+    out.push_back(byte_slice{std::move(objects_[0].stream)});
     return out;
   }
 }
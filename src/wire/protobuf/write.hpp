@@ -29,6 +29,7 @@
 
 #include <cstdint>
 
+#include "byte_chain.hpp"
 #include "byte_stream.hpp"
 #include "span.hpp"
 #include "wire/field.hpp"
@@ -44,9 +45,10 @@ namespace wire
     struct object_data
     {
       object_data()
-	: stream(), id()
+	: chain(), stream(), id()
       {}
 
+      byte_chain chain;   //!< Completed bytes that precede `stream`
       byte_stream stream;
       unsigned id;
     };
@@ -86,7 +88,11 @@ namespace wire
     void key(unsigned, const char*) override final;
     void end_object() override final;
 
+    //! \return Output as a single contiguous buffer.
     byte_stream take_sink();
+
+    //! \return Output without flattening spliced nested objects.
+    byte_chain take_chain();
   };
 
   template<typename T, typename U>
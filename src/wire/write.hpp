@@ -33,7 +33,9 @@
 #include <string>
 #include <type_traits>
 
+#include "byte_chain.hpp"
 #include "byte_slice.hpp"
+#include "byte_stream.hpp"
 #include "span.hpp"
 #include "wire/error.hpp"
 #include "wire/field.hpp"
@@ -198,6 +200,23 @@ namespace wire_write
     return {};
   }
 
+  template<typename W, typename T>
+  inline std::error_code to_bytes(byte_chain& dest, const T& source)
+  {
+    dest.clear();
+    try
+    {
+      W out{byte_stream{}};
+      bytes(out, source);
+      dest = out.take_chain();
+    }
+    catch (const wire::exception& e)
+    {
+      return e.code();
+    }
+    return {};
+  }
+
   template<typename W, typename T>
   inline void array(W& dest, const T& source, const std::size_t count)
   {